@@ -124,6 +124,11 @@ int CommandLineInterface::execute() noexcept {
          "containing custom settings. If not set, the settings from the boards "
          "will be used instead."),
       tr("file"));
+  QCommandLineOption optimizeDrillPathOption(
+      "optimize-drill-path",
+      tr("Optimize the order of drill hits in exported Excellon files to "
+         "reduce the travel distance of the drilling machine. Overrides the "
+         "corresponding PCB fabrication output setting."));
   QCommandLineOption boardOption("board",
                                  tr("The name of the board(s) to export. Can "
                                     "be given multiple times. If not set, "
@@ -172,6 +177,7 @@ int CommandLineInterface::execute() noexcept {
     parser.addOption(bomAttributesOption);
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(pcbFabricationSettingsOption);
+    parser.addOption(optimizeDrillPathOption);
     parser.addOption(boardOption);
     parser.addOption(saveOption);
     parser.addOption(prjStrictOption);
@@ -243,6 +249,7 @@ int CommandLineInterface::execute() noexcept {
         parser.value(bomAttributesOption),             // BOM attributes
         parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
         parser.value(pcbFabricationSettingsOption),    // PCB fab. settings
+        parser.isSet(optimizeDrillPathOption),         // optimize drill path
         parser.values(boardOption),                    // boards
         parser.isSet(saveOption),                      // save project
         parser.isSet(prjStrictOption)                  // strict mode
@@ -279,7 +286,8 @@ bool CommandLineInterface::openProject(
     const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
     const QStringList& exportBoardBomFiles, const QString& bomAttributes,
     bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
-    const QStringList& boards, bool save, bool strict) const noexcept {
+    bool optimizeDrillPath, const QStringList& boards, bool save,
+    bool strict) const noexcept {
   try {
     bool                success = true;
     QMap<FilePath, int> writtenFilesCounter;
@@ -488,9 +496,13 @@ bool CommandLineInterface::openProject(
       }
       foreach (const Board* board, boardList) {
         print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
-        BoardGerberExport grbExport(
-            *board, customSettings ? *customSettings
-                                   : board->getFabricationOutputSettings());
+        BoardFabricationOutputSettings settings =
+            customSettings ? *customSettings
+                           : board->getFabricationOutputSettings();
+        if (optimizeDrillPath) {
+          settings.setOptimizeDrillPath(true);
+        }
+        BoardGerberExport grbExport(*board, settings);
         grbExport.exportAllLayers();  // can throw
         foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
           print(QString("    => '%1'").arg(prettyPath(fp, projectFile)));
@@ -66,8 +66,8 @@ private:  // Methods
                    const QStringList& exportBoardBomFiles,
                    const QString& bomAttributes, bool exportPcbFabricationData,
                    const QString&     pcbFabricationSettingsPath,
-                   const QStringList& boards, bool save, bool strict) const
-      noexcept;
+                   bool optimizeDrillPath, const QStringList& boards,
+                   bool save, bool strict) const noexcept;
   bool openLibrary(const QString& libDir, bool all, bool save,
                    bool strict) const noexcept;
   void processLibraryElement(const QString& libDir, TransactionalFileSystem& fs,
@@ -22,10 +22,12 @@
  ******************************************************************************/
 #include "airwiresbuilder.h"
 
-#include <unordered_map>
+#include <delaunay-triangulation/delaunay.h>
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -35,7 +37,7 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-AirWiresBuilder::AirWiresBuilder() noexcept {
+AirWiresBuilder::AirWiresBuilder() noexcept : mCandidateEdgesValid(false) {
 }
 
 AirWiresBuilder::~AirWiresBuilder() noexcept {
@@ -47,148 +49,171 @@ AirWiresBuilder::~AirWiresBuilder() noexcept {
 
 int AirWiresBuilder::addPoint(const Point& p) noexcept {
   int id = mPoints.size();
-  mPoints.emplace_back(p.getX().toNm(), p.getY().toNm(), id);
+  mPoints.push_back(p);
+  mRemovedPoints.push_back(false);
+  mCandidateEdgesValid = false;
   return id;
 }
 
-void AirWiresBuilder::addEdge(int p1, int p2) noexcept {
-  mEdges.emplace_back(mPoints[p1], mPoints[p2], -1);
+void AirWiresBuilder::removePoint(int id) noexcept {
+  Q_ASSERT((id >= 0) && (id < static_cast<int>(mPoints.size())));
+  mRemovedPoints[id] = true;
+  mEdges.erase(std::remove_if(mEdges.begin(), mEdges.end(),
+                              [id](const std::pair<int, int>& edge) {
+                                return (edge.first == id) ||
+                                       (edge.second == id);
+                              }),
+               mEdges.end());
+  mCandidateEdgesValid = false;
 }
 
-AirWiresBuilder::AirWires AirWiresBuilder::buildAirWires() noexcept {
-  // remember how many edges are already known as connected
-  uint connectedEdges = mEdges.size();
-
-  // determine additional edges between found points (candidates for airwires)
-  if (mPoints.size() == 2) {
-    mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-  } else if (mPoints.size() == 3) {
-    // manually triangulate since it is easy and more stable than the
-    // delaunay-triangulation library
-    mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-    mEdges.emplace_back(mPoints[1], mPoints[2], -1);
-    mEdges.emplace_back(mPoints[2], mPoints[0], -1);
-  } else if (mPoints.size() >= 3) {
-    // since delaunay-triangulation sometimes doesn't work well, add fallback
-    // edges to make sure at least all points are connected somehow
-    for (std::size_t i = 1; i < mPoints.size(); ++i) {
-      mEdges.emplace_back(mPoints[i - 1], mPoints[i], -1);
-    }
+void AirWiresBuilder::addEdge(int p1, int p2) noexcept {
+  Q_ASSERT((p1 >= 0) && (p1 < static_cast<int>(mPoints.size())));
+  Q_ASSERT((p2 >= 0) && (p2 < static_cast<int>(mPoints.size())));
+  mEdges.emplace_back(p1, p2);  // does not affect the triangulation
+}
 
-    // now run delaunay triangulation to add additional edges
-    delaunay::Delaunay<qreal> del;
-    del.triangulate(mPoints);
-    mEdges.insert(mEdges.end(), del.getEdges().begin(), del.getEdges().end());
+void AirWiresBuilder::removeEdge(int p1, int p2) noexcept {
+  auto it = std::find_if(mEdges.begin(), mEdges.end(),
+                         [p1, p2](const std::pair<int, int>& edge) {
+                           return ((edge.first == p1) && (edge.second == p2)) ||
+                                  ((edge.first == p2) && (edge.second == p1));
+                         });
+  if (it != mEdges.end()) {
+    mEdges.erase(it);
   }
+}
 
-  // determine weights of these new edges
-  for (uint i = connectedEdges; i < mEdges.size(); ++i) {
-    mEdges[i].weight = mEdges[i].p1.dist2(mEdges[i].p2);
+AirWiresBuilder::AirWires AirWiresBuilder::buildAirWires() noexcept {
+  if (!mCandidateEdgesValid) {
+    updateCandidateEdges();
   }
 
-  // find airwires in list of edges
-  return AirWiresBuilder::kruskalMst();
+  // Kruskal's algorithm: Start with each point in its own subtree, merge the
+  // subtrees of already connected points, then add the shortest candidate
+  // edges which connect different subtrees until there's only one left.
+  mParents.resize(mPoints.size());
+  mRanks.assign(mPoints.size(), 0);
+  int subtrees = 0;
+  for (std::size_t i = 0; i < mPoints.size(); ++i) {
+    mParents[i] = i;
+    if (!mRemovedPoints[i]) ++subtrees;
+  }
+  for (const std::pair<int, int>& edge : mEdges) {
+    if (unite(edge.first, edge.second)) --subtrees;
+  }
+  AirWires airwires;
+  for (const Edge& edge : mCandidateEdges) {
+    if (subtrees <= 1) break;
+    if (unite(edge.p1, edge.p2)) {
+      airwires.append(qMakePair(mPoints[edge.p1], mPoints[edge.p2]));
+      --subtrees;
+    }
+  }
+  return airwires;
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-// adapted from horizon/kicad
-AirWiresBuilder::AirWires AirWiresBuilder::kruskalMst() noexcept {
-  unsigned int nodeNumber      = mPoints.size();
-  unsigned int mstExpectedSize = nodeNumber - 1;
-  unsigned int mstSize         = 0;
-  bool         ratsnestLines   = false;
-
-  // printf("mst nodes : %d edges : %d\n", mPoints.size(), mEdges.size () );
-  // The output
-  AirWires mst;
-
-  // Set tags for marking cycles
-  std::unordered_map<int, int> tags;
-  unsigned int                 tag = 0;
+void AirWiresBuilder::updateCandidateEdges() noexcept {
+  mCandidateEdges.clear();
 
-  for (auto& node : mPoints) {
-    node.tag      = tag;
-    tags[node.id] = tag++;
+  // Coincident points (e.g. pads of stacked footprints) are a problem for the
+  // triangulation, and they are connected with zero-length candidate edges
+  // anyway. So only the first point at each position is triangulated.
+  std::vector<int> ids;
+  ids.reserve(mPoints.size());
+  for (std::size_t i = 0; i < mPoints.size(); ++i) {
+    if (!mRemovedPoints[i]) ids.push_back(i);
   }
+  std::stable_sort(ids.begin(), ids.end(), [this](int a, int b) {
+    return (mPoints[a].getX() < mPoints[b].getX()) ||
+           ((mPoints[a].getX() == mPoints[b].getX()) &&
+            (mPoints[a].getY() < mPoints[b].getY()));
+  });
+  std::vector<int> uniqueIds;
+  uniqueIds.reserve(ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    if ((i > 0) && (mPoints[ids[i]] == mPoints[uniqueIds.back()])) {
+      addCandidateEdge(uniqueIds.back(), ids[i]);
+    } else {
+      uniqueIds.push_back(ids[i]);
+    }
+  }
+  std::sort(uniqueIds.begin(), uniqueIds.end());  // back to insertion order
 
-  // Lists of nodes connected together (subtrees) to detect cycles in the
-  // graph
-  std::vector<std::list<int>> cycles(nodeNumber);
+  // determine edges between the points (candidates for airwires)
+  if (uniqueIds.size() == 2) {
+    addCandidateEdge(uniqueIds[0], uniqueIds[1]);
+  } else if (uniqueIds.size() == 3) {
+    // manually triangulate since it is easy and more stable than the
+    // delaunay-triangulation library
+    addCandidateEdge(uniqueIds[0], uniqueIds[1]);
+    addCandidateEdge(uniqueIds[1], uniqueIds[2]);
+    addCandidateEdge(uniqueIds[2], uniqueIds[0]);
+  } else if (uniqueIds.size() > 3) {
+    // since delaunay-triangulation sometimes doesn't work well, add fallback
+    // edges to make sure at least all points are connected somehow
+    for (std::size_t i = 1; i < uniqueIds.size(); ++i) {
+      addCandidateEdge(uniqueIds[i - 1], uniqueIds[i]);
+    }
 
-  for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+    // now run delaunay triangulation to add additional edges
+    std::vector<delaunay::Vector2<qreal>> vertices;
+    vertices.reserve(uniqueIds.size());
+    for (int id : uniqueIds) {
+      vertices.emplace_back(mPoints[id].getX().toNm(),
+                            mPoints[id].getY().toNm(), id);
+    }
+    delaunay::Delaunay<qreal> del;
+    del.triangulate(vertices);
+    for (const delaunay::Edge<qreal>& edge : del.getEdges()) {
+      addCandidateEdge(edge.p1.id, edge.p2.id);
+    }
+  }
 
-  // Kruskal algorithm requires edges to be sorted by their weight
-  std::sort(mEdges.begin(), mEdges.end(),
-            [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
-              return a.weight > b.weight;
+  // Kruskal's algorithm requires the edges to be sorted by their length
+  std::sort(mCandidateEdges.begin(), mCandidateEdges.end(),
+            [](const Edge& a, const Edge& b) {
+              if (a.weight != b.weight) return a.weight < b.weight;
+              return std::make_pair(a.p1, a.p2) < std::make_pair(b.p1, b.p2);
             });
+  mCandidateEdgesValid = true;
+}
 
-  while (mstSize < mstExpectedSize && !mEdges.empty()) {
-    auto& dt = mEdges.back();
-
-    int srcTag = tags[dt.p1.id];
-    int trgTag = tags[dt.p2.id];
-    // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-    // dt.weight, srcTag, trgTag);
-
-    // Check if by adding this edge we are going to join two different
-    // forests
-    if (srcTag != trgTag) {
-      // Because edges are sorted by their weight, first we always process
-      // connected
-      // items (weight == 0). Once we stumble upon an edge with non-zero
-      // weight,
-      // it means that the rest of the lines are ratsnest.
-      if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
-
-      // Update tags
-      if (ratsnestLines) {
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[mPoints[*it].id] = srcTag;
-        }
-
-        // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-        // RN_EDGE,
-        // RN_EDGE_MST saves both source and target node and does not
-        // require any other
-        // edges to exist for getting source/target nodes
-        // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-        // dt.GetWeight() );
-
-        // assert( newEdge.GetSourceNode()->GetTag() !=
-        // newEdge.GetTargetNode()->GetTag() );
-        // assert(dt.p1.tag != dt.p2.tag);
-        mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
-        ++mstSize;
-      } else {
-        // for( it = cycles[trgTag].begin(), itEnd =
-        // cycles[trgTag].end(); it != itEnd; ++it )
-        // for( auto it : cycles[trgTag] )
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[mPoints[*it].id] = srcTag;
-          mPoints[*it].tag      = srcTag;
-        }
-
-        // Processing a connection, decrease the expected size of the
-        // ratsnest MST
-        --mstExpectedSize;
-      }
-
-      // Move nodes that were marked with old tag to the list marked with
-      // the new tag
-      cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
-    }
+void AirWiresBuilder::addCandidateEdge(int p1, int p2) noexcept {
+  // subtract the integer coordinates first to avoid rounding errors
+  qint64 dx = (mPoints[p2].getX() - mPoints[p1].getX()).toNm();
+  qint64 dy = (mPoints[p2].getY() - mPoints[p1].getY()).toNm();
+  mCandidateEdges.push_back(
+      Edge{p1, p2, static_cast<qreal>(dx) * dx + static_cast<qreal>(dy) * dy});
+}
 
-    // Remove the edge that was just processed
-    mEdges.pop_back();
+int AirWiresBuilder::findRoot(int id) noexcept {
+  // path halving keeps the trees flat
+  while (mParents[id] != id) {
+    mParents[id] = mParents[mParents[id]];
+    id           = mParents[id];
   }
+  return id;
+}
 
-  return mst;
+bool AirWiresBuilder::unite(int p1, int p2) noexcept {
+  int root1 = findRoot(p1);
+  int root2 = findRoot(p2);
+  if (root1 == root2) {
+    return false;  // already in the same subtree
+  }
+  if (mRanks[root1] < mRanks[root2]) {
+    std::swap(root1, root2);
+  }
+  mParents[root2] = root1;
+  if (mRanks[root1] == mRanks[root2]) {
+    ++mRanks[root1];
+  }
+  return true;
 }
 
 /*******************************************************************************
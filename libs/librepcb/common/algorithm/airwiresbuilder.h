@@ -25,10 +25,10 @@
  ******************************************************************************/
 #include "../units/point.h"
 
-#include <delaunay-triangulation/delaunay.h>
-
 #include <QtCore>
 
+#include <vector>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -40,6 +40,15 @@ namespace librepcb {
 
 /**
  * @brief The AirWiresBuilder class
+ *
+ * Determines the air wires of a net as the minimum spanning tree over the
+ * edges of a Delaunay triangulation of all points. Known connections between
+ * points (e.g. traces) are added as edges.
+ *
+ * The (sorted) triangulation is cached and only recalculated if points were
+ * added or removed since the last call to ::buildAirWires(). So a builder can
+ * be kept and updated incrementally, which is much faster for nets with many
+ * points when only the connections between them changed.
  */
 class AirWiresBuilder final {
   Q_DECLARE_TR_FUNCTIONS(AirWiresBuilder)
@@ -77,6 +86,15 @@ public:
    */
   int addPoint(const Point& p) noexcept;
 
+  /**
+   * @brief Remove a point and all its edges
+   *
+   * The IDs of all other points remain valid.
+   *
+   * @param id  ID of the point to remove
+   */
+  void removePoint(int id) noexcept;
+
   /**
    * @brief Add an edge between two points
    *
@@ -85,6 +103,14 @@ public:
    */
   void addEdge(int p1, int p2) noexcept;
 
+  /**
+   * @brief Remove an edge between two points
+   *
+   * @param p1  ID of first point
+   * @param p2  ID of second point
+   */
+  void removeEdge(int p1, int p2) noexcept;
+
   /**
    * @brief Build the air wires
    *
@@ -95,12 +121,31 @@ public:
   // Operator overloadings
   AirWiresBuilder& operator=(const AirWiresBuilder& rhs) = delete;
 
+private:  // Types
+  struct Edge {
+    int   p1;
+    int   p2;
+    qreal weight;
+  };
+
 private:  // Methods
-  AirWires kruskalMst() noexcept;
+  void updateCandidateEdges() noexcept;
+  void addCandidateEdge(int p1, int p2) noexcept;
+  int  findRoot(int id) noexcept;
+  bool unite(int p1, int p2) noexcept;
 
 private:  // Data
-  std::vector<delaunay::Vector2<qreal>> mPoints;
-  std::vector<delaunay::Edge<qreal>>    mEdges;
+  std::vector<Point>               mPoints;         ///< Indexed by ID
+  std::vector<bool>                mRemovedPoints;  ///< Indexed by ID
+  std::vector<std::pair<int, int>> mEdges;          ///< Known connections
+
+  /// Airwire candidates (triangulation), sorted by length
+  std::vector<Edge> mCandidateEdges;
+  bool              mCandidateEdgesValid;
+
+  // Union-find buffers, indexed by ID
+  std::vector<int> mParents;
+  std::vector<int> mRanks;
 };
 
 /*******************************************************************************
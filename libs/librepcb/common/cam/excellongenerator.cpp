@@ -26,6 +26,12 @@
 
 #include <QtCore>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <set>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -35,7 +41,8 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-ExcellonGenerator::ExcellonGenerator() noexcept : mOutput() {
+ExcellonGenerator::ExcellonGenerator() noexcept
+  : mOutput(), mOptimizeToolPath(false) {
 }
 
 ExcellonGenerator::~ExcellonGenerator() noexcept {
@@ -98,13 +105,19 @@ void ExcellonGenerator::printToolList() noexcept {
 }
 
 void ExcellonGenerator::printDrills() noexcept {
+  Point lastPos;  // the drill head starts at the origin
   for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
     mOutput.append(QString("T%1\n").arg(i + 1));  // Select Tool
-    Length dia = mDrillList.uniqueKeys().value(i);
-    foreach (const Point& pos, mDrillList.values(dia)) {
+    Length       dia       = mDrillList.uniqueKeys().value(i);
+    QList<Point> positions = mDrillList.values(dia);
+    if (mOptimizeToolPath) {
+      positions = optimizeToolPath(positions, lastPos);
+    }
+    foreach (const Point& pos, positions) {
       mOutput.append(
           QString("X%1Y%2\n")
               .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+      lastPos = pos;
     }
   }
 }
@@ -114,6 +127,189 @@ void ExcellonGenerator::printFooter() noexcept {
   mOutput.append("M30\n");  // End of Program Rewind
 }
 
+QList<Point> ExcellonGenerator::optimizeToolPath(
+    const QList<Point>& positions, const Point& start) noexcept {
+  // The start position is the first point and stays fixed, the end is open.
+  QVector<Point> points;
+  points.reserve(positions.count() + 1);
+  points.append(start);
+  points += positions.toVector();
+  const int count = points.count();
+
+  // floating point distances are precise enough and much faster to calculate
+  auto x = [&points](int i) { return qreal(points.at(i).getX().toNm()); };
+  auto y = [&points](int i) { return qreal(points.at(i).getY().toNm()); };
+  auto squaredDistance = [&](int a, int b) {
+    qreal dx = x(b) - x(a);
+    qreal dy = y(b) - y(a);
+    return dx * dx + dy * dy;
+  };
+  auto distance = [&](int a, int b) {
+    return std::sqrt(squaredDistance(a, b));
+  };
+
+  // The nearest neighbour searches below work on the points sorted along the
+  // axis with the larger extent (e.g. Y for a column of holes), so they can
+  // stop as soon as the distance along this axis is larger than the best
+  // match found so far.
+  qreal minX = x(0), maxX = x(0), minY = y(0), maxY = y(0);
+  for (int i = 1; i < count; ++i) {
+    minX = qMin(minX, x(i));
+    maxX = qMax(maxX, x(i));
+    minY = qMin(minY, y(i));
+    maxY = qMax(maxY, y(i));
+  }
+  const bool sortByY = (maxY - minY) > (maxX - minX);
+  auto       key     = [&](int i) { return sortByY ? y(i) : x(i); };
+
+  // Build an initial path with the nearest neighbour heuristic.
+  std::set<std::pair<qreal, int>> remaining;
+  for (int i = 1; i < count; ++i) {
+    remaining.insert(std::make_pair(key(i), i));
+  }
+  QVector<int> path;
+  path.reserve(count);
+  path.append(0);
+  while (!remaining.empty()) {
+    const int current         = path.last();
+    auto      nearest         = remaining.end();
+    qreal     nearestDistance = 0;
+    auto check = [&](std::set<std::pair<qreal, int>>::iterator it) -> bool {
+      qreal dk = it->first - key(current);
+      if ((nearest != remaining.end()) && (dk * dk >= nearestDistance)) {
+        return false;  // all following points are even farther away
+      }
+      qreal d = squaredDistance(current, it->second);
+      if ((nearest == remaining.end()) || (d < nearestDistance)) {
+        nearest         = it;
+        nearestDistance = d;
+      }
+      return true;
+    };
+    auto it = remaining.lower_bound(std::make_pair(key(current), 0));
+    for (auto i = it; (i != remaining.end()) && check(i); ++i) {
+    }
+    for (auto i = it; (i != remaining.begin()) && check(std::prev(i)); --i) {
+    }
+    path.append(nearest->second);
+    remaining.erase(nearest);
+  }
+
+  // Determine the nearest neighbours of every point as candidates for the
+  // 2-opt moves below, again with the help of the sorted points.
+  static const int neighbourCount = 8;
+  QVector<int>     sorted(count);
+  for (int i = 0; i < count; ++i) {
+    sorted[i] = i;
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [&](int a, int b) { return key(a) < key(b); });
+  QVector<QVector<int>> neighbours(count);
+  for (int s = 0; s < count; ++s) {
+    const int                  a = sorted.at(s);
+    QVector<QPair<qreal, int>> best;  // sorted by distance
+    auto check = [&](int b) -> bool {
+      qreal dk = key(b) - key(a);
+      if ((best.count() == neighbourCount) && (dk * dk >= best.last().first)) {
+        return false;  // all following points are even farther away
+      }
+      QPair<qreal, int> candidate(squaredDistance(a, b), b);
+      if ((best.count() < neighbourCount) || (candidate < best.last())) {
+        best.insert(std::upper_bound(best.begin(), best.end(), candidate),
+                    candidate);
+        if (best.count() > neighbourCount) {
+          best.removeLast();
+        }
+      }
+      return true;
+    };
+    for (int i = s + 1; (i < count) && check(sorted.at(i)); ++i) {
+    }
+    for (int i = s - 1; (i >= 0) && check(sorted.at(i)); --i) {
+    }
+    foreach (const auto& neighbour, best) {
+      neighbours[a].append(neighbour.second);
+    }
+  }
+
+  // Improve the path with 2-opt, i.e. reverse the section [i..j] of the path
+  // as long as this makes the path shorter (by at least 1nm, to avoid endless
+  // loops due to rounding errors). Only moves which connect a point with one
+  // of its nearest neighbours are considered, and only if the new connection
+  // is shorter than the replaced one. Points whose surrounding did not change
+  // since they were checked the last time are skipped ("don't look bits").
+  QVector<int> indices(count);  // index of each point in the path
+  for (int i = 0; i < count; ++i) {
+    indices[path.at(i)] = i;
+  }
+  QVector<bool> queued(count, true);
+  QQueue<int>   queue;
+  for (int i = 0; i < count; ++i) {
+    queue.enqueue(path.at(i));
+  }
+  auto tryReverse = [&](int i, int j) -> bool {
+    qreal delta = distance(path.at(i - 1), path.at(j)) -
+                  distance(path.at(i - 1), path.at(i));
+    if (j < count - 1) {
+      delta += distance(path.at(i), path.at(j + 1)) -
+               distance(path.at(j), path.at(j + 1));
+    }
+    if (delta >= -1) {
+      return false;
+    }
+    std::reverse(path.begin() + i, path.begin() + j + 1);
+    for (int k = i; k <= j; ++k) {
+      indices[path.at(k)] = k;
+    }
+    for (int k : {i - 1, i, j, j + 1}) {
+      if ((k < count) && (!queued.at(path.at(k)))) {
+        queued[path.at(k)] = true;
+        queue.enqueue(path.at(k));
+      }
+    }
+    return true;
+  };
+  while (!queue.isEmpty()) {
+    const int a = queue.dequeue();
+    queued[a]   = false;
+    bool improved;
+    do {
+      improved    = false;
+      const int p = indices.at(a);
+      // replace the connection to the successor of a (if any)
+      qreal succDistance = (p < count - 1)
+          ? squaredDistance(a, path.at(p + 1))
+          : std::numeric_limits<qreal>::max();
+      foreach (int c, neighbours.at(a)) {
+        if (squaredDistance(a, c) >= succDistance) break;
+        const int q = indices.at(c);
+        if (((q > p + 1) && tryReverse(p + 1, q)) ||
+            ((q < p) && tryReverse(q + 1, p))) {
+          improved = true;
+          break;
+        }
+      }
+      // replace the connection to the predecessor of a (if any)
+      qreal predDistance =
+          (p > 0) ? squaredDistance(a, path.at(p - 1)) : qreal(0);
+      foreach (int c, neighbours.at(a)) {
+        if (improved || (squaredDistance(a, c) >= predDistance)) break;
+        const int q = indices.at(c);
+        if (((q > p + 1) && tryReverse(p, q - 1)) ||
+            ((q > 0) && (q < p - 1) && tryReverse(q, p - 1))) {
+          improved = true;
+        }
+      }
+    } while (improved);
+  }
+
+  QList<Point> result;
+  for (int i = 1; i < count; ++i) {
+    result.append(points.at(path.at(i)));
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -54,6 +54,11 @@ public:
   // Getters
   const QString& toStr() const noexcept { return mOutput; }
 
+  // Setters
+  void setOptimizeToolPath(bool optimize) noexcept {
+    mOptimizeToolPath = optimize;
+  }
+
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia) noexcept;
   void generate();
@@ -68,10 +73,13 @@ private:
   void printToolList() noexcept;
   void printDrills() noexcept;
   void printFooter() noexcept;
+  static QList<Point> optimizeToolPath(const QList<Point>& positions,
+                                       const Point&        start) noexcept;
 
   // Excellon Data
   QString                  mOutput;
   QMultiMap<Length, Point> mDrillList;
+  bool                     mOptimizeToolPath;
 };
 
 /*******************************************************************************
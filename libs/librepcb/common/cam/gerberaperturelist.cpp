@@ -46,12 +46,18 @@ GerberApertureList::~GerberApertureList() noexcept {
 QString GerberApertureList::generateString() const noexcept {
   QString str;
   str.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  foreach (const QString& macro, mApertureMacros) {
-    str.append(QString("%AM%1*%\n").arg(macro));
+  QStringList macros;  // in the order of their first usage
+  foreach (const Aperture& aperture, mApertures) {
+    QString macro = generateMacro(aperture);
+    if ((!macro.isEmpty()) && (!macros.contains(macro))) {
+      str.append(QString("%AM%1*%\n").arg(macro));
+      macros.append(macro);
+    }
   }
-  foreach (int number, mApertures.keys()) {
-    str.append(
-        QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+  for (int i = 0; i < mApertures.count(); ++i) {
+    str.append(QString("%ADD%1%2*%\n")
+                   .arg(i + 10)
+                   .arg(generateAperture(mApertures.at(i))));
   }
   str.append("G04 --- APERTURE LIST END --- *\n");
   return str;
@@ -63,25 +69,26 @@ QString GerberApertureList::generateString() const noexcept {
 
 int GerberApertureList::setCircle(const UnsignedLength& dia,
                                   const UnsignedLength& hole) {
-  return setCurrentAperture(generateCircle(dia, hole));
+  return setCurrentAperture(
+      Aperture{Type::Circle, {dia->toNm(), hole->toNm()}});
 }
 
 int GerberApertureList::setRect(const UnsignedLength& w,
                                 const UnsignedLength& h, const Angle& rot,
                                 const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateRect(w, h, hole));
+    return setCurrentAperture(
+        Aperture{Type::Rect, {w->toNm(), h->toNm(), hole->toNm()}});
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateRect(h, w, hole));
+    return setCurrentAperture(
+        Aperture{Type::Rect, {h->toNm(), w->toNm(), hole->toNm()}});
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
-    if (hole > 0) {
-      addMacro(generateRotatedRectMacroWithHole());
-    } else {
-      addMacro(generateRotatedRectMacro());
-    }
-    return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+    Angle keyRot = normalizeRotation(rot, Angle::deg180());  // symmetric
+    return setCurrentAperture(Aperture{
+        Type::RotatedRect,
+        {w->toNm(), h->toNm(), keyRot.toMicroDeg(), hole->toNm()}});
   }
 }
 
@@ -89,18 +96,27 @@ int GerberApertureList::setObround(const UnsignedLength& w,
                                    const UnsignedLength& h, const Angle& rot,
                                    const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateObround(w, h, hole));
+    return setCurrentAperture(
+        Aperture{Type::Obround, {w->toNm(), h->toNm(), hole->toNm()}});
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateObround(h, w, hole));
+    return setCurrentAperture(
+        Aperture{Type::Obround, {h->toNm(), w->toNm(), hole->toNm()}});
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
-    // macro
-    if (hole > 0) {
-      addMacro(generateRotatedObroundMacroWithHole());
-    } else {
-      addMacro(generateRotatedObroundMacro());
+    // macro. Its parameters are the end points of the obround, rounded to
+    // nanometers, so they are used as key. The obround is symmetric, so the
+    // order of the end points doesn't matter.
+    UnsignedLength width = (w < h ? w : h);
+    Point          start = Point(-w / 2 + width / 2, 0).rotated(rot);
+    Point          end   = Point(w / 2 - width / 2, 0).rotated(rot);
+    if ((end.getX() < start.getX()) ||
+        ((end.getX() == start.getX()) && (end.getY() < start.getY()))) {
+      std::swap(start, end);
     }
-    return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+    return setCurrentAperture(Aperture{
+        Type::RotatedObround,
+        {start.getX().toNm(), start.getY().toNm(), end.getX().toNm(),
+         end.getY().toNm(), width->toNm(), hole->toNm()}});
   }
 }
 
@@ -115,50 +131,109 @@ int GerberApertureList::setRegularPolygon(const UnsignedLength& dia, int n,
   // Adjust rotation as its interpretation differs between LibrePCB and Gerber
   // specs
   Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-  return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+  grbRot = normalizeRotation(grbRot, Angle::deg360());
+  return setCurrentAperture(
+      Aperture{Type::RegularPolygon,
+               {dia->toNm(), n, grbRot.toMicroDeg(), hole->toNm()}});
 }
 
 int GerberApertureList::setOctagon(const UnsignedLength& w,
                                    const UnsignedLength& h,
                                    const UnsignedLength& edge, const Angle& rot,
                                    const UnsignedLength& hole) noexcept {
-  if (hole > 0) {
-    addMacro(generateRotatedOctagonMacroWithHole());
-  } else {
-    addMacro(generateRotatedOctagonMacro());
-  }
-  return setCurrentAperture(generateRotatedOctagon(w, h, edge, rot, hole));
+  Angle keyRot = normalizeRotation(rot, Angle::deg180());  // symmetric
+  return setCurrentAperture(Aperture{
+      Type::RotatedOctagon,
+      {w->toNm(), h->toNm(), edge->toNm(), keyRot.toMicroDeg(),
+       hole->toNm()}});
 }
 
 void GerberApertureList::reset() noexcept {
-  // mApertureMacros.clear();
   mApertures.clear();
+  mApertureNumbers.clear();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept {
-  int number = mApertures.key(aperture, -1);
-  if (number < 0) {
-    number = mApertures.count() + 10;  // 10 is the number of the first aperture
-    Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, aperture);
+int GerberApertureList::setCurrentAperture(const Aperture& aperture) noexcept {
+  auto it = mApertureNumbers.constFind(aperture);
+  if (it != mApertureNumbers.constEnd()) {
+    return it.value();
   }
+  int number = mApertures.count() + 10;  // 10 is the number of the first one
+  mApertures.append(aperture);
+  mApertureNumbers.insert(aperture, number);
   return number;
 }
 
-void GerberApertureList::addMacro(const QString& macro) noexcept {
-  if (!mApertureMacros.contains(macro)) {
-    mApertureMacros.append(macro);
+Angle GerberApertureList::normalizeRotation(const Angle& rot,
+                                            const Angle& period) noexcept {
+  Angle normalized = rot % period;
+  if (normalized < 0) {
+    normalized += period;
   }
+  return normalized;
 }
 
 /*******************************************************************************
  *  Aperture Generator Methods
  ******************************************************************************/
 
+QString GerberApertureList::generateAperture(
+    const Aperture& aperture) noexcept {
+  auto length = [&aperture](int i) {
+    return UnsignedLength(Length(aperture.params[i]));
+  };
+  auto angle = [&aperture](int i) {
+    return Angle(static_cast<qint32>(aperture.params[i]));
+  };
+  auto point = [&aperture](int i) {
+    return Point(Length(aperture.params[i]), Length(aperture.params[i + 1]));
+  };
+  switch (aperture.type) {
+    case Type::Circle:
+      return generateCircle(length(0), length(1));
+    case Type::Rect:
+      return generateRect(length(0), length(1), length(2));
+    case Type::Obround:
+      return generateObround(length(0), length(1), length(2));
+    case Type::RegularPolygon:
+      return generateRegularPolygon(length(0),
+                                    static_cast<int>(aperture.params[1]),
+                                    angle(2), length(3));
+    case Type::RotatedRect:
+      return generateRotatedRect(length(0), length(1), angle(2), length(3));
+    case Type::RotatedObround:
+      return generateRotatedObround(point(0), point(2), length(4),
+                                    length(5));
+    case Type::RotatedOctagon:
+      return generateRotatedOctagon(length(0), length(1), length(2), angle(3),
+                                    length(4));
+    default:
+      qCritical() << "Unhandled aperture type:"
+                  << static_cast<int>(aperture.type);
+      return QString();
+  }
+}
+
+QString GerberApertureList::generateMacro(const Aperture& aperture) noexcept {
+  switch (aperture.type) {
+    case Type::RotatedRect:
+      return (aperture.params[3] > 0) ? generateRotatedRectMacroWithHole()
+                                      : generateRotatedRectMacro();
+    case Type::RotatedObround:
+      return (aperture.params[5] > 0) ? generateRotatedObroundMacroWithHole()
+                                      : generateRotatedObroundMacro();
+    case Type::RotatedOctagon:
+      return (aperture.params[4] > 0) ? generateRotatedOctagonMacroWithHole()
+                                      : generateRotatedOctagonMacro();
+    default:
+      return QString();  // no macro needed
+  }
+}
+
 QString GerberApertureList::generateCircle(
     const UnsignedLength& dia, const UnsignedLength& hole) noexcept {
   if (hole > 0) {
@@ -269,11 +344,8 @@ QString GerberApertureList::generateRotatedRect(
 }
 
 QString GerberApertureList::generateRotatedObround(
-    const UnsignedLength& w, const UnsignedLength& h, const Angle& rot,
+    const Point& start, const Point& end, const UnsignedLength& width,
     const UnsignedLength& hole) noexcept {
-  UnsignedLength width = (w < h ? w : h);
-  Point          start = Point(-w / 2 + width / 2, 0).rotated(rot);
-  Point          end   = Point(w / 2 - width / 2, 0).rotated(rot);
   if (hole > 0) {
     return QString("ROTATEDOBROUNDWITHHOLE,%1X%2X%3X%4X%5X%6")
         .arg(start.getX().toMmString(), start.getY().toMmString(),
@@ -30,6 +30,8 @@
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -41,6 +43,10 @@ namespace librepcb {
 
 /**
  * @brief The GerberApertureList class
+ *
+ * Apertures are identified by a structural key (type and dimensions) to
+ * quickly find already existing apertures. Their textual definitions are
+ * generated only once in #generateString().
  */
 class GerberApertureList final {
   Q_DECLARE_TR_FUNCTIONS(GerberApertureList)
@@ -71,12 +77,50 @@ public:
   // Operator Overloadings
   GerberApertureList& operator=(const GerberApertureList& rhs) = delete;
 
+private:  // Types
+  enum class Type {
+    Circle,          ///< params: diameter, hole
+    Rect,            ///< params: width, height, hole
+    Obround,         ///< params: width, height, hole
+    RegularPolygon,  ///< params: diameter, vertices, rotation, hole
+    RotatedRect,     ///< params: width, height, rotation, hole
+    RotatedObround,  ///< params: x1, y1, x2, y2, width, hole
+    RotatedOctagon,  ///< params: width, height, edge, rotation, hole
+  };
+
+  /**
+   * Structural key of an aperture (lengths in nm, angles in microdegrees)
+   *
+   * The parameters are normalized (e.g. rotations are mapped to the range
+   * where the shape is not repeated), so apertures which look the same share
+   * one key.
+   */
+  struct Aperture {
+    Type   type;
+    qint64 params[6];  ///< unused parameters are zero
+
+    bool operator==(const Aperture& rhs) const noexcept {
+      return (type == rhs.type) &&
+             std::equal(params, params + 6, rhs.params);
+    }
+    friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+      uint hash = ::qHash(static_cast<int>(key.type), seed);
+      for (qint64 param : key.params) {
+        hash = (hash * 31) + ::qHash(param, seed);
+      }
+      return hash;
+    }
+  };
+
 private:
   // Private Methods
-  int  setCurrentAperture(const QString& aperture) noexcept;
-  void addMacro(const QString& macro) noexcept;
+  int          setCurrentAperture(const Aperture& aperture) noexcept;
+  static Angle normalizeRotation(const Angle& rot,
+                                 const Angle& period) noexcept;
 
   // Aperture Generator Methods
+  static QString generateAperture(const Aperture& aperture) noexcept;
+  static QString generateMacro(const Aperture& aperture) noexcept;
   static QString generateCircle(const UnsignedLength& dia,
                                 const UnsignedLength& hole) noexcept;
   static QString generateRect(const UnsignedLength& w, const UnsignedLength& h,
@@ -96,9 +140,9 @@ private:
   static QString generateRotatedRect(const UnsignedLength& w,
                                      const UnsignedLength& h, const Angle& rot,
                                      const UnsignedLength& hole) noexcept;
-  static QString generateRotatedObround(const UnsignedLength& w,
-                                        const UnsignedLength& h,
-                                        const Angle&          rot,
+  static QString generateRotatedObround(const Point&          start,
+                                        const Point&          end,
+                                        const UnsignedLength& width,
                                         const UnsignedLength& hole) noexcept;
   static QString generateRotatedOctagon(const UnsignedLength& w,
                                         const UnsignedLength& h,
@@ -106,9 +150,8 @@ private:
                                         const Angle&          rot,
                                         const UnsignedLength& hole) noexcept;
 
-  QList<QString> mApertureMacros;
-  QMap<int, QString>
-      mApertures;  ///< key: aperture number (>= 10); value: aperture definition
+  QVector<Aperture>    mApertures;  ///< index: aperture number - 10
+  QHash<Aperture, int> mApertureNumbers;  ///< value: aperture number (>= 10)
 };
 
 /*******************************************************************************
@@ -30,6 +30,8 @@
 
 #include <QtCore>
 
+#include <cstring>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -44,8 +46,10 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
   : mProjectId(escapeString(projName)),
     mProjectUuid(projUuid),
     mProjectRevision(escapeString(projRevision)),
-    mOutput(),
+    mCreationDate(),
     mContent(),
+    mSpoolFile(),
+    mSpoolFailed(false),
     mApertureList(new GerberApertureList()),
     mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false) {
@@ -165,22 +169,50 @@ void GerberGenerator::flashOctagon(const Point& pos, const UnsignedLength& w,
  ******************************************************************************/
 
 void GerberGenerator::reset() noexcept {
-  mOutput.clear();
   mContent.clear();
+  mSpoolFile.reset();
+  mSpoolFailed = false;
   mApertureList->reset();
   mCurrentApertureNumber = -1;
 }
 
 void GerberGenerator::generate() {
-  mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
+  // The output is streamed together when saving it, so only check if the
+  // content was spooled successfully. The creation date is determined here
+  // to get the same output from every call to toStr() and saveToFile().
+  mCreationDate = QDateTime::currentDateTime();
+  if (mSpoolFailed || (mSpoolFile && (!mSpoolFile->flush()))) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(tr("Could not write to temporary file \"%1\": %2"))
+            .arg(mSpoolFile ? mSpoolFile->fileName() : QString(),
+                 mSpoolFile ? mSpoolFile->errorString() : QString()));
+  }
+}
+
+QString GerberGenerator::toStr() const {
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  if (!writeOutput(buffer)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Could not read the Gerber spool file."));
+  }
+  return QString::fromLatin1(buffer.data());
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::makePath(filepath.getParentDir());  // can throw
+  QSaveFile file(filepath.toStr());
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not open or create file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+  if ((!writeOutput(file)) || (!file.commit())) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not write to file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+  }
 }
 
 /*******************************************************************************
@@ -189,7 +221,9 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const {
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    appendNumber(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -229,13 +263,15 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D02*\n");
+  spoolContentIfNeeded();
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D01*\n");
+  spoolContentIfNeeded();
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
@@ -245,9 +281,13 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start,
   if (!mMultiQuadrantArcModeOn) {
     diff.makeAbs();  // no sign allowed in single quadrant mode!
   }
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendPosition(end);
+  mContent.append('I');
+  appendNumber(mContent, diff.getX().toNm());
+  mContent.append('J');
+  appendNumber(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
+  spoolContentIfNeeded();
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from, const Vertex& to) noexcept {
@@ -272,70 +312,106 @@ void GerberGenerator::interpolateBetween(const Vertex& from, const Vertex& to) n
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D03*\n");
+  spoolContentIfNeeded();
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+void GerberGenerator::appendPosition(const Point& pos) noexcept {
+  mContent.append('X');
+  appendNumber(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  appendNumber(mContent, pos.getY().toNm());
+}
+
+void GerberGenerator::spoolContentIfNeeded() noexcept {
+  // Keep small layers in memory, only big ones are moved to a spool file.
+  if ((mContent.size() < 1024 * 1024) || mSpoolFailed) {
+    return;
+  }
+  if (!mSpoolFile) {
+    mSpoolFile.reset(new QTemporaryFile());
+    if (!mSpoolFile->open()) {
+      // keep the whole content in memory, that's not nice but works too
+      qWarning() << "Could not create Gerber spool file:"
+                 << mSpoolFile->errorString();
+      mSpoolFile.reset();
+      mSpoolFailed = true;  // do not try it again
+      return;
+    }
+  }
+  // append to the end, the position might have been changed by writeOutput()
+  if (mSpoolFile->seek(mSpoolFile->size()) &&
+      (mSpoolFile->write(mContent) == mContent.size())) {
+    mContent.clear();
+  } else {
+    mSpoolFailed = true;  // reported by generate()
+  }
+}
+
+QString GerberGenerator::generateHeader() const noexcept {
+  QString header;
+  header.append("G04 --- HEADER BEGIN --- *\n");
 
   // add some X2 attributes
   QString appVersion   = qApp->applicationVersion();
-  QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-  QString projId       = mProjectId.remove(',');
+  QString creationDate = mCreationDate.toString(Qt::ISODate);
+  QString projId       = QString(mProjectId).remove(',');
   QString projUuid     = mProjectUuid.toStr();
-  QString projRevision = mProjectRevision.remove(',');
-  mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
-                     .arg(appVersion));
-  mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-  mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
-                     .arg(projId, projUuid, projRevision));
-  mOutput.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
-  // mOutput.append("%TF.FilePolarity,Positive*%\n");
+  QString projRevision = QString(mProjectRevision).remove(',');
+  header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
+                    .arg(appVersion));
+  header.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
+  header.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
+                    .arg(projId, projUuid, projRevision));
+  header.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
+  // header.append("%TF.FilePolarity,Positive*%\n");
 
   // coordinate format specification:
   //  - leading zeros omitted
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  header.append("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  header.append("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  header.append("G01*\n");
 
   // use single quadrant arc mode
-  mOutput.append("G74*\n");
+  header.append("G74*\n");
 
-  mOutput.append("G04 --- HEADER END --- *\n");
+  header.append("G04 --- HEADER END --- *\n");
+  return header;
 }
 
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append(mApertureList->generateString());
-}
-
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
-}
+bool GerberGenerator::writeOutput(QIODevice& device) const noexcept {
+  // according to the RS-274C standard, linebreaks are not included in the
+  // checksum
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  if (!writeChunk(device, &md5, generateHeader().toLatin1())) return false;
+  if (!writeChunk(device, &md5, mApertureList->generateString().toLatin1())) {
+    return false;
+  }
+  if (!writeChunk(device, &md5, "G04 --- BOARD BEGIN --- *\n")) return false;
+  if (mSpoolFile) {
+    if (!mSpoolFile->seek(0)) return false;
+    while (!mSpoolFile->atEnd()) {
+      QByteArray chunk = mSpoolFile->read(1024 * 1024);
+      if (chunk.isEmpty() || (!writeChunk(device, &md5, chunk))) return false;
+    }
+  }
+  if (!writeChunk(device, &md5, mContent)) return false;
+  if (!writeChunk(device, &md5, "G04 --- BOARD END --- *\n")) return false;
 
-void GerberGenerator::printFooter() noexcept {
   // MD5 checksum over content
-  mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+  QByteArray footer = "%TF.MD5," + md5.result().toHex() + "*%\n";
 
   // end of file
-  mOutput.append("M02*\n");
-}
-
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
-  // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  footer.append("M02*\n");
+  return writeChunk(device, nullptr, footer);
 }
 
 /*******************************************************************************
@@ -356,6 +432,40 @@ QString GerberGenerator::escapeString(const QString& str) noexcept {
   return ret;
 }
 
+void GerberGenerator::appendNumber(QByteArray& output, qint64 number) noexcept {
+  // much faster than QString::number() since it does not care about locales
+  char  buffer[24];
+  char* end = buffer + sizeof(buffer);
+  char* p   = end;
+  quint64 value =
+      (number < 0) ? (quint64(0) - quint64(number)) : quint64(number);
+  do {
+    *--p = char('0' + (value % 10));
+    value /= 10;
+  } while (value > 0);
+  if (number < 0) {
+    *--p = '-';
+  }
+  output.append(p, int(end - p));
+}
+
+bool GerberGenerator::writeChunk(QIODevice&          device,
+                                 QCryptographicHash* checksum,
+                                 const QByteArray&   data) noexcept {
+  if (checksum) {
+    const char* begin = data.constData();
+    const char* end   = begin + data.size();
+    while (begin < end) {
+      const char* lf = static_cast<const char*>(
+          std::memchr(begin, '\n', end - begin));
+      if (!lf) lf = end;
+      checksum->addData(begin, int(lf - begin));
+      begin = lf + 1;
+    }
+  }
+  return device.write(data) == data.size();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -47,6 +47,12 @@ class Vertex;
 /**
  * @brief The GerberGenerator class
  *
+ * The plot methods append the Gerber commands to a buffer which is moved to a
+ * temporary spool file when it gets large. Since the aperture list needs to be
+ * written before the content, the output is streamed together from the header,
+ * the aperture list and the spooled content in #saveToFile(). So the memory
+ * usage does not depend on the size of the generated layer.
+ *
  * @todo Remove/Escape illegal characters in
  *       ::librepcb::GerberGenerator::mProjectId and
  *       ::librepcb::GerberGenerator::mProjectRevision!
@@ -68,9 +74,6 @@ public:
                   const QString& projRevision) noexcept;
   ~GerberGenerator() noexcept;
 
-  // Getters
-  const QString& toStr() const noexcept { return mOutput; }
-
   // Plot Methods
   void setLayerPolarity(LayerPolarity p) noexcept;
   void drawLine(const Point& start, const Point& end,
@@ -96,9 +99,10 @@ public:
                     const Angle& rot, const UnsignedLength& hole) noexcept;
 
   // General Methods
-  void reset() noexcept;
-  void generate();
-  void saveToFile(const FilePath& filepath) const;
+  void    reset() noexcept;
+  void    generate();
+  QString toStr() const;
+  void    saveToFile(const FilePath& filepath) const;
 
   // Operator Overloadings
   GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
@@ -119,23 +123,27 @@ private:
                                         const Point& end) noexcept;
   void    interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void    flashAtPosition(const Point& pos) noexcept;
-  void    printHeader() noexcept;
-  void    printApertureList() noexcept;
-  void    printContent() noexcept;
-  void    printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  void    appendPosition(const Point& pos) noexcept;
+  void    spoolContentIfNeeded() noexcept;
+  QString generateHeader() const noexcept;
+  bool    writeOutput(QIODevice& device) const noexcept;
 
   // Static Methods
   static QString escapeString(const QString& str) noexcept;
+  static void    appendNumber(QByteArray& output, qint64 number) noexcept;
+  static bool    writeChunk(QIODevice& device, QCryptographicHash* checksum,
+                            const QByteArray& data) noexcept;
 
   // Metadata
-  QString mProjectId;
-  Uuid    mProjectUuid;
-  QString mProjectRevision;
+  QString   mProjectId;
+  Uuid      mProjectUuid;
+  QString   mProjectRevision;
+  QDateTime mCreationDate;  ///< Determined by #generate()
 
   // Gerber Data
-  QString                            mOutput;
-  QString                            mContent;
+  QByteArray                         mContent;  ///< Not yet spooled content
+  QScopedPointer<QTemporaryFile>     mSpoolFile;  ///< nullptr if not needed
+  bool                               mSpoolFailed;
   QScopedPointer<GerberApertureList> mApertureList;
   int                                mCurrentApertureNumber;
   bool                               mMultiQuadrantArcModeOn;
@@ -26,6 +26,9 @@
 
 #include <QtCore>
 
+#include <array>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -35,42 +38,22 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-SExpression::SExpression() noexcept : mType(Type::String) {
+SExpression::SExpression() noexcept
+  : mType(Type::String), mLine(-1), mColumn(-1) {
 }
 
 SExpression::SExpression(Type type, const QString& value)
-  : mType(type), mValue(value) {
+  : mType(type), mLine(-1), mColumn(-1), mValue(value) {
 }
 
 SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
+    mLine(other.mLine),
+    mColumn(other.mColumn),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
-}
-
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
+    mFilePath(other.mFilePath),
+    mChildIndex(std::atomic_load(&other.mChildIndex)) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -80,6 +63,11 @@ SExpression::~SExpression() noexcept {
  *  Getters
  ******************************************************************************/
 
+const FilePath& SExpression::getFilePath() const noexcept {
+  static const FilePath empty;
+  return mFilePath ? *mFilePath : empty;
+}
+
 bool SExpression::isMultiLineList() const noexcept {
   foreach (const SExpression& child, mChildren) {
     if (child.isLineBreak() || (child.isMultiLineList())) {
@@ -93,29 +81,39 @@ const QString& SExpression::getName() const {
   if (isList()) {
     return mValue;
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Node is not a list."));
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                         QString(), tr("Node is not a list."));
   }
 }
 
 const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
   if (!isToken() && !isString()) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
-                         tr("Node is not a token or string."));
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                         mValue, tr("Node is not a token or string."));
   }
   if (mValue.isEmpty() && throwIfEmpty) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
-                         tr("Node value is empty."));
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                         mValue, tr("Node value is empty."));
   }
   return mValue;
 }
 
-QList<SExpression> SExpression::getChildren(const QString& name) const
+SExpression::ChildRefs SExpression::getChildren(const QString& name) const
     noexcept {
-  QList<SExpression> children;
-  foreach (const SExpression& child, mChildren) {
-    if (child.isList() && (child.mValue == name)) {
-      children.append(child);
+  // Note: Only references are returned since copying the child nodes (and
+  // allocating them in a QList) is very expensive for big files.
+  ChildRefs children;
+  if (std::shared_ptr<const ChildIndex> index = getChildIndex()) {
+    auto it = index->constFind(name);
+    if (it != index->constEnd()) {
+      children.reserve(it->count());
+      foreach (int i, *it) { children.append(std::cref(mChildren.at(i))); }
+    }
+  } else {
+    foreach (const SExpression& child, mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        children.append(std::cref(child));
+      }
     }
   }
   return children;
@@ -123,7 +121,8 @@ QList<SExpression> SExpression::getChildren(const QString& name) const
 
 const SExpression& SExpression::getChildByIndex(int index) const {
   if ((index < 0) || index >= mChildren.count()) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                         QString(),
                          QString(tr("Child not found: %1")).arg(index));
   }
   return mChildren.at(index);
@@ -133,14 +132,8 @@ const SExpression* SExpression::tryGetChildByPath(const QString& path) const
     noexcept {
   const SExpression* child = this;
   foreach (const QString& name, path.split('/')) {
-    bool found = false;
-    foreach (const SExpression& childchild, child->mChildren) {
-      if (childchild.isList() && (childchild.mValue == name)) {
-        child = &childchild;
-        found = true;
-      }
-    }
-    if (!found) {
+    child = child->tryGetChild(name);
+    if (!child) {
       return nullptr;
     }
   }
@@ -152,7 +145,8 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
   if (child) {
     return *child;
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                         QString(),
                          QString(tr("Child not found: %1")).arg(path));
   }
 }
@@ -163,6 +157,7 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
 
 SExpression& SExpression::appendLineBreak() {
   mChildren.append(createLineBreak());
+  std::atomic_store(&mChildIndex, std::shared_ptr<const ChildIndex>());
   return *this;
 }
 
@@ -175,6 +170,7 @@ SExpression& SExpression::appendChild(const SExpression& child,
   if (mType == Type::List) {
     if (linebreak) appendLineBreak();
     mChildren.append(child);
+    std::atomic_store(&mChildIndex, std::shared_ptr<const ChildIndex>());
     return mChildren.last();
   } else {
     throw LogicError(__FILE__, __LINE__);
@@ -187,12 +183,14 @@ void SExpression::removeLineBreaks() noexcept {
       mChildren.removeAt(i);
     }
   }
+  std::atomic_store(&mChildIndex, std::shared_ptr<const ChildIndex>());
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  str += '\n';                // newline at end of file
-  return str.toUtf8();
+  QByteArray output;
+  appendToByteArray(output, 0);  // can throw
+  output += '\n';                // newline at end of file
+  return output;
 }
 
 /*******************************************************************************
@@ -204,6 +202,9 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
   mValue    = rhs.mValue;
   mChildren = rhs.mChildren;
   mFilePath = rhs.mFilePath;
+  mLine     = rhs.mLine;
+  mColumn   = rhs.mColumn;
+  std::atomic_store(&mChildIndex, std::atomic_load(&rhs.mChildIndex));
   return *this;
 }
 
@@ -211,30 +212,131 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) const noexcept {
-  return QString::fromStdString(sexpresso::escape(string.toStdString()));
+const SExpression* SExpression::tryGetChild(const QString& name) const
+    noexcept {
+  // Note: If there are multiple children with the same name, the last one is
+  // returned.
+  if (std::shared_ptr<const ChildIndex> index = getChildIndex()) {
+    auto it = index->constFind(name);
+    return (it != index->constEnd()) ? &mChildren.at(it->last()) : nullptr;
+  }
+  for (int i = mChildren.count() - 1; i >= 0; --i) {
+    const SExpression& child = mChildren.at(i);
+    if (child.isList() && (child.mValue == name)) {
+      return &child;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const SExpression::ChildIndex> SExpression::getChildIndex()
+    const noexcept {
+  // For lists with only a few children, a linear search is faster than
+  // building the index.
+  if (mChildren.count() < 16) {
+    return nullptr;
+  }
+  std::shared_ptr<const ChildIndex> index = std::atomic_load(&mChildIndex);
+  if (!index) {
+    // If multiple threads get here at the same time, each of them builds
+    // the same index, which doesn't hurt.
+    std::shared_ptr<ChildIndex> newIndex = std::make_shared<ChildIndex>();
+    for (int i = 0; i < mChildren.count(); ++i) {
+      const SExpression& child = mChildren.at(i);
+      if (child.isList()) {
+        (*newIndex)[child.mValue].append(i);
+      }
+    }
+    index = newIndex;
+    std::atomic_store(&mChildIndex, index);
+  }
+  return index;
+}
+
+// Character classes for the validation of tokens and list names, and to find
+// the string characters which never need to be escaped.
+enum SExpressionCharClass : quint8 {
+  CharClassListNameFirst = 0x01,  // [a-z]
+  CharClassListName      = 0x02,  // [a-z0-9_]
+  CharClassToken         = 0x04,  // [a-zA-Z0-9\.:_-]
+  CharClassPlainString   = 0x08,  // printable ASCII except ["'?\\]
+};
+
+static const quint8* getSExpressionCharClasses() noexcept {
+  static const std::array<quint8, 128> table = []() {
+    std::array<quint8, 128> t = {};
+    for (int c = 0x20; c < 0x7F; ++c) {
+      if ((c != '"') && (c != '\'') && (c != '?') && (c != '\\')) {
+        t[c] |= CharClassPlainString;
+      }
+      if ((c >= 'a') && (c <= 'z')) {
+        t[c] |= CharClassListNameFirst | CharClassListName | CharClassToken;
+      } else if ((c >= '0') && (c <= '9')) {
+        t[c] |= CharClassListName | CharClassToken;
+      } else if (c == '_') {
+        t[c] |= CharClassListName | CharClassToken;
+      } else if (((c >= 'A') && (c <= 'Z')) || (c == '.') || (c == ':') ||
+                 (c == '-')) {
+        t[c] |= CharClassToken;
+      }
+    }
+    return t;
+  }();
+  return table.data();
+}
+
+void SExpression::appendEscapedString(QByteArray&    output,
+                                      const QString& string) const noexcept {
+  const quint8* classes = getSExpressionCharClasses();
+  for (const QChar& c : string) {
+    ushort u = c.unicode();
+    if ((u >= 128) || (!(classes[u] & CharClassPlainString))) {
+      // rare case, let sexpresso do the escaping
+      std::string escaped = sexpresso::escape(string.toStdString());
+      output.append(escaped.data(), escaped.size());
+      return;
+    }
+  }
+  output += string.toLatin1();  // only printable ASCII characters
 }
 
 bool SExpression::isValidListName(const QString& name) const noexcept {
-  return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
+  const quint8* classes = getSExpressionCharClasses();
+  for (int i = 0; i < name.length(); ++i) {
+    ushort c        = name.at(i).unicode();
+    quint8 required = (i == 0) ? CharClassListNameFirst : CharClassListName;
+    if ((c >= 128) || (!(classes[c] & required))) {
+      return false;
+    }
+  }
+  return !name.isEmpty();
 }
 
 bool SExpression::isValidToken(const QString& token) const noexcept {
-  return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+  const quint8* classes = getSExpressionCharClasses();
+  for (const QChar& c : token) {
+    if ((c.unicode() >= 128) || (!(classes[c.unicode()] & CharClassToken))) {
+      return false;
+    }
+  }
+  return !token.isEmpty();
 }
 
-QString SExpression::toString(int indent) const {
+bool SExpression::appendToByteArray(QByteArray& output, int indent) const {
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
     }
-    QString str = '(' + mValue;
+    output += '(';
+    output += mValue.toLatin1();  // only ASCII characters
+    bool isMultiLine = false;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+      if ((output.at(output.length() - 1) != ' ') &&
+          (output.at(output.length() - 1) != '\n') && (!child.isLineBreak())) {
+        output += ' ';
       }
       bool nextChildIsLineBreak = (i < mChildren.count() - 1)
                                       ? mChildren.at(i + 1).isLineBreak()
@@ -243,27 +345,38 @@ QString SExpression::toString(int indent) const {
         if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          output += '\n';
         }
-      } else {
-        str += child.toString(indent + 1);
+      } else if (child.appendToByteArray(output, indent + 1)) {
+        isMultiLine = true;
+      }
+      if (child.isLineBreak()) {
+        isMultiLine = true;
       }
     }
-    if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+    if (isMultiLine) {
+      output += '\n';
+      output += QByteArray(indent, ' ');
     }
-    return str + ')';
+    output += ')';
+    return isMultiLine;
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression token: %1")).arg(mValue));
     }
-    return mValue;
+    output += mValue.toLatin1();  // only ASCII characters
+    return false;
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output += '"';
+    appendEscapedString(output, mValue);
+    output += '"';
+    return false;
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output += '\n';
+    output += QByteArray(indent, ' ');
+    return false;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -289,22 +402,239 @@ SExpression SExpression::createLineBreak() {
   return SExpression(Type::LineBreak, QString());
 }
 
-SExpression SExpression::parse(const QByteArray& content,
-                               const FilePath&   filePath) {
-  std::string     error;
-  QString         str  = QString::fromUtf8(content);
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
+SExpression SExpression::parse(const QByteArray&    content,
+                               const FilePath&      filePath,
+                               int                  maxDepth,
+                               const QSet<QString>& headerNames) {
+  // All nodes share the same file path object and, if equal, the same list
+  // name and short token string data. Most tokens are short numbers like
+  // "0.0" or keywords, which are repeated very often in big files.
+  std::shared_ptr<const FilePath> path =
+      std::make_shared<FilePath>(filePath);
+  QHash<QByteArray, QString> names;
+  QHash<QByteArray, QString> tokens;
+  auto intern = [](QHash<QByteArray, QString>& strings, const char* str,
+                   int len) -> const QString& {
+    QByteArray key = QByteArray::fromRawData(str, len);
+    auto       it  = strings.find(key);
+    if (it == strings.end()) {
+      it = strings.insert(QByteArray(str, len), QString::fromUtf8(str, len));
+    }
+    return *it;
+  };
+
+  // Stack of the currently open lists, where the first element is a pseudo
+  // list containing the root node(s).
+  QList<SExpression> stack;
+  stack.append(SExpression(Type::List, QString()));
+  bool expectListName = false;
+  bool headerRead     = false;
+
+  const char* data      = content.constData();
+  const int   size      = content.size();
+  int         pos       = 0;
+  int         line      = 1;
+  int         lineStart = 0;  // position of the first byte of the line
+  if (content.startsWith("\xEF\xBB\xBF")) {
+    pos = lineStart = 3;  // skip UTF-8 byte order mark
+  }
+
+  auto createNode = [&](Type type, const QString& value, int startPos) {
+    SExpression node(type, value);
+    node.mFilePath = path;
+    node.mLine     = line;
+    node.mColumn   = startPos - lineStart + 1;
+    return node;
+  };
+  auto parseError = [&](int errorPos, const QString& msg) {
+    return FileParseError(__FILE__, __LINE__, filePath, line,
+                          errorPos - lineStart + 1, QString(), msg);
+  };
+  // Whether the list on top of the stack is a child of the root node which
+  // does not belong to the header anymore, i.e. parsing can be stopped.
+  auto isEndOfHeader = [&]() {
+    return (!headerNames.isEmpty()) && (stack.count() == 3) &&
+           (!headerNames.contains(stack.last().mValue));
+  };
+  auto isSpace = [](char c) {
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') ||
+           (c == '\v') || (c == '\f');
+  };
+
+  while (pos < size) {
+    const char c = data[pos];
+    if (c == '\n') {
+      ++line;
+      lineStart = ++pos;
+    } else if (isSpace(c)) {
+      ++pos;
+    } else if (c == ';') {
+      // comment until end of line
+      while ((pos < size) && (data[pos] != '\n')) ++pos;
+    } else if (expectListName && ((c == '(') || (c == ')'))) {
+      throw parseError(pos, tr("List does not have a name."));
+    } else if ((c == '(') && (maxDepth >= 0) &&
+               (stack.count() > maxDepth + 1)) {
+      // skip the whole list since it is nested too deep
+      int depth = 0;
+      while (pos < size) {
+        const char ch = data[pos++];
+        if (ch == '\n') {
+          ++line;
+          lineStart = pos;
+        } else if (ch == ';') {
+          while ((pos < size) && (data[pos] != '\n')) ++pos;
+        } else if (ch == '"') {
+          while ((pos < size) && (data[pos] != '"')) {
+            if (data[pos] == '\\') {
+              ++pos;  // skip escaped character
+            } else if (data[pos] == '\n') {
+              ++line;
+              lineStart = pos + 1;
+            }
+            ++pos;
+          }
+          ++pos;  // skip closing quote
+        } else if (ch == '(') {
+          ++depth;
+        } else if ((ch == ')') && (--depth == 0)) {
+          break;
+        }
+      }
+    } else if (c == '(') {
+      stack.append(createNode(Type::List, QString(), pos));
+      expectListName = true;
+      ++pos;
+    } else if (c == ')') {
+      if (stack.count() < 2) {
+        throw parseError(pos, tr("Unexpected closing parenthesis."));
+      }
+      SExpression list = stack.takeLast();
+      stack.last().mChildren.append(list);
+      ++pos;
+    } else if (c == '"') {
+      // Note: Tokens and strings are both parsed as strings.
+      SExpression node       = createNode(Type::String, QString(), pos);
+      int         start      = ++pos;
+      bool        hasEscapes = false;
+      while ((pos < size) && (data[pos] != '"')) {
+        if (data[pos] == '\\') {
+          hasEscapes = true;
+          ++pos;  // skip escaped character
+        } else if (data[pos] == '\n') {
+          ++line;
+          lineStart = pos + 1;
+        }
+        ++pos;
+      }
+      if (pos >= size) {
+        throw FileParseError(__FILE__, __LINE__, filePath, node.mLine,
+                             node.mColumn, QString(),
+                             tr("Unterminated string."));
+      }
+      if (hasEscapes) {
+        QByteArray value;
+        value.reserve(pos - start);
+        for (int i = start; i < pos; ++i) {
+          if (data[i] == '\\') {
+            ++i;
+            switch (data[i]) {
+              case '"':
+              case '\\':
+              case '\'':
+              case '?':
+                value.append(data[i]);
+                break;
+              case 'a':
+                value.append('\a');
+                break;
+              case 'b':
+                value.append('\b');
+                break;
+              case 'f':
+                value.append('\f');
+                break;
+              case 'n':
+                value.append('\n');
+                break;
+              case 'r':
+                value.append('\r');
+                break;
+              case 't':
+                value.append('\t');
+                break;
+              case 'v':
+                value.append('\v');
+                break;
+              default:
+                throw FileParseError(
+                    __FILE__, __LINE__, filePath, node.mLine, node.mColumn,
+                    QString('\\') + QString::fromUtf8(&data[i], 1),
+                    tr("Invalid escape sequence in string."));
+            }
+          } else {
+            value.append(data[i]);
+          }
+        }
+        node.mValue = QString::fromUtf8(value);
+      } else {
+        node.mValue = QString::fromUtf8(&data[start], pos - start);
+      }
+      if (expectListName) {
+        stack.last().mValue = node.mValue;  // quoted list name
+        expectListName      = false;
+        if (isEndOfHeader()) {
+          stack.removeLast();
+          headerRead = true;
+          break;
+        }
+      } else {
+        stack.last().mChildren.append(node);
+      }
+      ++pos;
     } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
+      int start = pos;
+      while ((pos < size) && (!isSpace(data[pos])) && (data[pos] != '(') &&
+             (data[pos] != ')')) {
+        ++pos;
+      }
+      if (expectListName) {
+        stack.last().mValue = intern(names, &data[start], pos - start);
+        expectListName      = false;
+        if (isEndOfHeader()) {
+          stack.removeLast();
+          headerRead = true;
+          break;
+        }
+      } else {
+        // Note: Tokens and strings are both parsed as strings.
+        SExpression node = createNode(Type::String, QString(), start);
+        if (pos - start <= 8) {
+          node.mValue = intern(tokens, &data[start], pos - start);
+        } else {
+          node.mValue = QString::fromUtf8(&data[start], pos - start);
+        }
+        stack.last().mChildren.append(node);
+      }
     }
-  } else {
+  }
+
+  if (headerRead) {
+    // the rest of the root node is ignored
+    SExpression root = stack.takeLast();
+    stack.last().mChildren.append(root);
+  }
+  if (stack.count() > 1) {
+    const SExpression& list = stack.last();
+    throw FileParseError(__FILE__, __LINE__, filePath, list.mLine,
+                         list.mColumn, QString(),
+                         tr("List is not closed."));
+  }
+  if (stack.first().mChildren.count() != 1) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
+                         tr("File does not have exactly one root node."));
   }
+  return stack.first().mChildren.first();
 }
 
 /*******************************************************************************
@@ -29,13 +29,12 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <functional>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -53,6 +52,11 @@ T deserializeFromSExpression(const SExpression& sexpr,
 
 /**
  * @brief The SExpression class
+ *
+ * Nodes created by ::parse() share the path of the parsed file and remember
+ * their line and column (1-based, in bytes) in the file to provide helpful
+ * error messages. For all other nodes, the file path is empty and the
+ * position is -1.
  */
 class SExpression final {
   Q_DECLARE_TR_FUNCTIONS(SExpression)
@@ -66,13 +70,18 @@ public:
     LineBreak,  ///< manual line break inside a List
   };
 
+  /// References to child nodes, see #getChildren(const QString&)
+  typedef QVector<std::reference_wrapper<const SExpression>> ChildRefs;
+
   // Constructors / Destructor
   SExpression() noexcept;
   SExpression(const SExpression& other) noexcept;
   ~SExpression() noexcept;
 
   // Getters
-  const FilePath& getFilePath() const noexcept { return mFilePath; }
+  const FilePath& getFilePath() const noexcept;
+  int             getLine() const noexcept { return mLine; }
+  int             getColumn() const noexcept { return mColumn; }
   Type            getType() const noexcept { return mType; }
   bool            isList() const noexcept { return mType == Type::List; }
   bool            isToken() const noexcept { return mType == Type::Token; }
@@ -82,18 +91,43 @@ public:
   const QString&            getName() const;
   const QString&            getStringOrToken(bool throwIfEmpty = false) const;
   const QList<SExpression>& getChildren() const { return mChildren; }
-  QList<SExpression>        getChildren(const QString& name) const noexcept;
+  ChildRefs                 getChildren(const QString& name) const noexcept;
   const SExpression&        getChildByIndex(int index) const;
   const SExpression* tryGetChildByPath(const QString& path) const noexcept;
   const SExpression& getChildByPath(const QString& path) const;
 
+  /**
+   * @brief Call a function for each child list with the given name
+   *
+   * Same as iterating over #getChildren(const QString&), but without
+   * allocating the list of references.
+   *
+   * @param name  The name of the child lists.
+   * @param fn    Function to call with each child, in the order of the file.
+   */
+  template <typename Fn>
+  void forEachChild(const QString& name, Fn fn) const {
+    if (std::shared_ptr<const ChildIndex> index = getChildIndex()) {
+      auto it = index->constFind(name);
+      if (it != index->constEnd()) {
+        foreach (int i, *it) { fn(mChildren.at(i)); }
+      }
+    } else {
+      foreach (const SExpression& child, mChildren) {
+        if (child.isList() && (child.mValue == name)) {
+          fn(child);
+        }
+      }
+    }
+  }
+
   template <typename T>
   T getValue(bool throwIfEmpty = false) const {
     try {
       return deserializeFromSExpression<T>(*this, throwIfEmpty);
     } catch (const Exception& e) {
-      throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
-                           e.getMsg());
+      throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                           mValue, e.getMsg());
     }
   }
 
@@ -106,8 +140,8 @@ public:
   template <typename T>
   T getValueOfFirstChild(bool throwIfEmpty = false) const {
     if (mChildren.count() < 1) {
-      throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                           tr("Node does not have children."));
+      throw FileParseError(__FILE__, __LINE__, getFilePath(), mLine, mColumn,
+                           QString(), tr("Node does not have children."));
     }
     return mChildren.at(0).getValue<T>(throwIfEmpty);
   }
@@ -136,22 +170,69 @@ public:
   static SExpression createToken(const QString& token);
   static SExpression createString(const QString& string);
   static SExpression createLineBreak();
-  static SExpression parse(const QByteArray& content, const FilePath& filePath);
+
+  /**
+   * @brief Parse a S-Expression file
+   *
+   * @param content   The file content to parse.
+   * @param filePath  The path of the file, used for error messages.
+   * @param maxDepth  If not negative, lists nested deeper than this below the
+   *                  root node are skipped (i.e. not added to their parent).
+   * @param headerNames If not empty, parsing stops at the first child list of
+   *                    the root node whose name is not contained in this set.
+   *                    Together with maxDepth, this allows to quickly read
+   *                    only the header of large files, without scanning the
+   *                    rest of the file.
+   *
+   * @return The root node of the file.
+   */
+  static SExpression parse(const QByteArray&    content,
+                           const FilePath&      filePath,
+                           int                  maxDepth    = -1,
+                           const QSet<QString>& headerNames = QSet<QString>());
+
+private:  // Types
+  /// Indices of the list children, by their name
+  typedef QHash<QString, QVector<int>> ChildIndex;
 
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
-
-  QString escapeString(const QString& string) const noexcept;
-  bool    isValidListName(const QString& name) const noexcept;
-  bool    isValidToken(const QString& token) const noexcept;
-  QString toString(int indent) const;
+  const SExpression* tryGetChild(const QString& name) const noexcept;
+  std::shared_ptr<const ChildIndex> getChildIndex() const noexcept;
+
+  void appendEscapedString(QByteArray& output, const QString& string) const
+      noexcept;
+  bool isValidListName(const QString& name) const noexcept;
+  bool isValidToken(const QString& token) const noexcept;
+
+  /**
+   * @brief Serialize this node and append it to a UTF-8 buffer
+   *
+   * @param output    The buffer to write into.
+   * @param indent    The indentation level of this node.
+   *
+   * @return Whether the serialized node is a multi-line list.
+   */
+  bool appendToByteArray(QByteArray& output, int indent) const;
 
 private:  // Data
-  Type               mType;
-  QString            mValue;  ///< either a list name, a token or a string
-  QList<SExpression> mChildren;
-  FilePath           mFilePath;
+  Type                            mType;
+  int                             mLine;    ///< -1 if not parsed
+  int                             mColumn;  ///< -1 if not parsed
+  QString                         mValue;   ///< list name, token or string
+  QList<SExpression>              mChildren;
+  std::shared_ptr<const FilePath> mFilePath;  ///< nullptr if not parsed
+
+  /**
+   * @brief Lazily built index for the lookup of children by name
+   *
+   * Only used for lists with many children, see #getChildIndex(). It is
+   * shared between copies of a node and reset whenever the children are
+   * modified. Since the index is built by const methods which may be called
+   * from multiple threads, it must only be accessed with std::atomic_load()
+   * and std::atomic_store().
+   */
+  mutable std::shared_ptr<const ChildIndex> mChildIndex;
 };
 
 /*******************************************************************************
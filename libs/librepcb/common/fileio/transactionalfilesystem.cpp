@@ -36,6 +36,8 @@
 #include <quazip/quazipfile.h>
 #endif
 
+#include <QtConcurrent/QtConcurrent>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -79,6 +81,9 @@ TransactionalFileSystem::TransactionalFileSystem(
 }
 
 TransactionalFileSystem::~TransactionalFileSystem() noexcept {
+  // A running autosave must be finished before the directory gets unlocked.
+  waitForAutosave();
+
   // Remove autosave directory as it is not needed in case the file system
   // was gracefully closed. We only need it if the application has crashed.
   // But if the file system is opened in read-only mode, or if an autosave was
@@ -183,7 +188,32 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 
 void TransactionalFileSystem::write(const QString&    path,
                                     const QByteArray& content) {
-  QString cleanedPath         = cleanPath(path);
+  QString cleanedPath = cleanPath(path);
+
+  // Skip writing unchanged content, otherwise every save would write all files
+  // to the disk again, even if only a few of them were actually modified. The
+  // file on the disk is hashed on its first write, not when reading it, to not
+  // slow down loading (which is done in worker threads as well).
+  if (!isRemoved(cleanedPath)) {
+    auto it = mFileHashes.constFind(cleanedPath);
+    if (it == mFileHashes.constEnd()) {
+      FilePath fp = mFilePath.getPathTo(cleanedPath);
+      if (fp.isExistingFile()) {
+        try {
+          it = mFileHashes.insert(cleanedPath,
+                                  calcHash(FileUtils::readFile(fp)));
+        } catch (const Exception& e) {
+          qWarning() << "Could not compare file with new content:"
+                     << e.getMsg();
+        }
+      }
+    }
+    if ((it != mFileHashes.constEnd()) && (it.value() == calcHash(content))) {
+      mModifiedFiles.remove(cleanedPath);  // same content as on the disk
+      return;
+    }
+  }
+
   mModifiedFiles[cleanedPath] = content;
   mRemovedFiles.remove(cleanedPath);
 }
@@ -288,10 +318,36 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 }
 
 void TransactionalFileSystem::autosave() {
-  saveDiff("autosave");  // can throw
+  autosaveAsync().waitForFinished();  // can throw
+}
+
+QFuture<void> TransactionalFileSystem::autosaveAsync() {
+  if (!mIsWritable) {
+    throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
+  }
+
+  // Two autosaves must never run at the same time since they write into the
+  // same directory.
+  waitForAutosave();
+
+  // The containers are implicitly shared, so copying them is cheap and the
+  // file system can be modified while the worker thread writes the snapshot.
+  FilePath                   root          = mFilePath;
+  QHash<QString, QByteArray> modifiedFiles = mModifiedFiles;
+  QSet<QString>              removedFiles  = mRemovedFiles;
+  QSet<QString>              removedDirs   = mRemovedDirs;
+  mAutosaveFuture = QtConcurrent::run(
+      [root, modifiedFiles, removedFiles, removedDirs]() {
+        writeDiff(root, "autosave", modifiedFiles, removedFiles,
+                  removedDirs);  // can throw
+      });
+  return mAutosaveFuture;
 }
 
 void TransactionalFileSystem::save() {
+  // wait until a running autosave is finished since it will be removed
+  waitForAutosave();
+
   // save to backup directory
   saveDiff("backup");  // can throw
 
@@ -325,6 +381,17 @@ void TransactionalFileSystem::save() {
                          mModifiedFiles.value(filepath));  // can throw
   }
 
+  // update the hashes of the files on the disk
+  foreach (const QString& filepath, mFileHashes.keys()) {
+    if (isRemoved(filepath)) {
+      mFileHashes.remove(filepath);
+    }
+  }
+  for (auto it = mModifiedFiles.constBegin(); it != mModifiedFiles.constEnd();
+       ++it) {
+    mFileHashes.insert(it.key(), calcHash(it.value()));
+  }
+
   // remove backup
   removeDiff("backup");  // can throw
 
@@ -404,33 +471,41 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
 }
 
 void TransactionalFileSystem::saveDiff(const QString& type) const {
-  QDateTime dt       = QDateTime::currentDateTime();
-  FilePath  dir      = mFilePath.getPathTo("." % type);
-  FilePath  filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
-
   if (!mIsWritable) {
     throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
   }
 
-  SExpression root = SExpression::createList("librepcb_" % type);
-  root.appendChild("created", dt, true);
-  root.appendChild("modified_files_directory", filesDir.getFilename(), true);
-  foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
-    root.appendChild("modified_file", filepath, true);
+  writeDiff(mFilePath, type, mModifiedFiles, mRemovedFiles,
+            mRemovedDirs);  // can throw
+}
+
+void TransactionalFileSystem::writeDiff(
+    const FilePath& root, const QString& type,
+    const QHash<QString, QByteArray>& modifiedFiles,
+    const QSet<QString>& removedFiles, const QSet<QString>& removedDirs) {
+  QDateTime dt       = QDateTime::currentDateTime();
+  FilePath  dir      = root.getPathTo("." % type);
+  FilePath  filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
+
+  SExpression index = SExpression::createList("librepcb_" % type);
+  index.appendChild("created", dt, true);
+  index.appendChild("modified_files_directory", filesDir.getFilename(), true);
+  foreach (const QString& filepath, Toolbox::sorted(modifiedFiles.keys())) {
+    index.appendChild("modified_file", filepath, true);
     FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+                         modifiedFiles.value(filepath));  // can throw
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
-    root.appendChild("removed_file", filepath, true);
+  foreach (const QString& filepath, Toolbox::sorted(removedFiles.values())) {
+    index.appendChild("removed_file", filepath, true);
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedDirs.values())) {
-    root.appendChild("removed_directory", filepath, true);
+  foreach (const QString& filepath, Toolbox::sorted(removedDirs.values())) {
+    index.appendChild("removed_directory", filepath, true);
   }
 
   // Writing the main file must be the last operation to "mark" this diff as
   // complete!
   FileUtils::writeFile(dir.getPathTo(type % ".lp"),
-                       root.toByteArray());  // can throw
+                       index.toByteArray());  // can throw
 }
 
 void TransactionalFileSystem::loadDiff(const FilePath& fp) {
@@ -469,6 +544,20 @@ void TransactionalFileSystem::removeDiff(const QString& type) {
   FileUtils::removeDirRecursively(dir);  // can throw
 }
 
+QByteArray TransactionalFileSystem::calcHash(
+    const QByteArray& content) noexcept {
+  return QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+}
+
+void TransactionalFileSystem::waitForAutosave() noexcept {
+  try {
+    mAutosaveFuture.waitForFinished();  // can throw
+  } catch (...) {
+    // Errors are reported by the caller of autosaveAsync() through the
+    // returned future, so don't report them a second time here.
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -150,12 +150,13 @@ public:
   virtual void removeDirRecursively(const QString& path = "") override;
 
   // General Methods
-  void        loadFromZip(const FilePath& fp);
-  void        exportToZip(const FilePath& fp) const;
-  void        discardChanges() noexcept;
-  QStringList checkForModifications() const;
-  void        autosave();
-  void        save();
+  void          loadFromZip(const FilePath& fp);
+  void          exportToZip(const FilePath& fp) const;
+  void          discardChanges() noexcept;
+  QStringList   checkForModifications() const;
+  void          autosave();
+  QFuture<void> autosaveAsync();
+  void          save();
 
   // Static Methods
   static std::shared_ptr<TransactionalFileSystem> open(
@@ -180,12 +181,18 @@ public:
   static QString cleanPath(QString path) noexcept;
 
 private:  // Methods
-  bool isRemoved(const QString& path) const noexcept;
-  void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
-                      const QString& dir) const;
-  void saveDiff(const QString& type) const;
-  void loadDiff(const FilePath& fp);
-  void removeDiff(const QString& type);
+  bool              isRemoved(const QString& path) const noexcept;
+  void              exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
+                                   const QString& dir) const;
+  void              saveDiff(const QString& type) const;
+  static void       writeDiff(const FilePath& root, const QString& type,
+                              const QHash<QString, QByteArray>& modifiedFiles,
+                              const QSet<QString>&              removedFiles,
+                              const QSet<QString>&              removedDirs);
+  void              loadDiff(const FilePath& fp);
+  void              removeDiff(const QString& type);
+  static QByteArray calcHash(const QByteArray& content) noexcept;
+  void              waitForAutosave() noexcept;
 
 private:  // Data
   FilePath      mFilePath;
@@ -197,6 +204,13 @@ private:  // Data
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString>              mRemovedFiles;
   QSet<QString>              mRemovedDirs;
+
+  /// Hashes of the content of the files on the disk, used to skip writing
+  /// unchanged content. Only contains files which were written or saved.
+  QHash<QString, QByteArray> mFileHashes;
+
+  // Asynchronous autosave
+  QFuture<void> mAutosaveFuture;  ///< The currently running autosave, if any
 };
 
 /*******************************************************************************
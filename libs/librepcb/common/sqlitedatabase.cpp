@@ -93,6 +93,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
 }
 
 SQLiteDatabase::~SQLiteDatabase() noexcept {
+  mCachedQueries.clear();  // queries must be released before closing
   mDb.close();
 }
 
@@ -160,6 +161,18 @@ QSqlQuery SQLiteDatabase::prepareQuery(const QString& query) const {
   return q;
 }
 
+QSqlQuery SQLiteDatabase::prepareCachedQuery(const QString& query) {
+  // Preparing a query takes some time, so queries which are executed very
+  // often (e.g. inserts when scanning the library) are prepared only once.
+  // Note that the returned object shares its state with the cached query, thus
+  // it must not be used anymore after the next call with the same SQL string.
+  auto it = mCachedQueries.find(query);
+  if (it == mCachedQueries.end()) {
+    it = mCachedQueries.insert(query, prepareQuery(query));  // can throw
+  }
+  return it.value();
+}
+
 int SQLiteDatabase::count(QSqlQuery& query) {
   exec(query);  // can throw
 
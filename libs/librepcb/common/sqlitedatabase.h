@@ -74,6 +74,7 @@ public:
 
   // General Methods
   QSqlQuery prepareQuery(const QString& query) const;
+  QSqlQuery prepareCachedQuery(const QString& query);
   int       count(QSqlQuery& query);
   int       insert(QSqlQuery& query);
   void      exec(QSqlQuery& query);
@@ -106,6 +107,9 @@ private:  // Methods
 private:  // Data
   QSqlDatabase mDb;
   // int mNestedTransactionCount;
+
+  /// Prepared queries for #prepareCachedQuery(), key is the SQL string
+  QHash<QString, QSqlQuery> mCachedQueries;
 };
 
 /*******************************************************************************
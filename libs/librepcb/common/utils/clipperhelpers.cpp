@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "clipperhelpers.h"
 
+#include "../toolbox.h"
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -73,6 +75,23 @@ void ClipperHelpers::unite(ClipperLib::Paths&       subject,
   }
 }
 
+std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteToTree(
+    const ClipperLib::Paths& paths) {
+  try {
+    // Non-zero filling to merge overlapping areas (which must have the same
+    // orientation, see convert()) instead of toggling them like even-odd.
+    std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
+    ClipperLib::Clipper                   c;
+    c.AddPaths(paths, ClipperLib::ptSubject, true);
+    c.Execute(ClipperLib::ctUnion, *result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString(tr("Failed to unite paths: %1")).arg(e.what()));
+  }
+}
+
 std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::intersect(
     const ClipperLib::Paths& subject, const ClipperLib::Paths& clip) {
   try {
@@ -118,6 +137,53 @@ void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
   }
 }
 
+void ClipperHelpers::simplify(ClipperLib::Paths&    paths,
+                              const UnsignedLength& tolerance) noexcept {
+  for (ClipperLib::Path& path : paths) {
+    if (path.size() < 3) {
+      continue;
+    }
+    // Douglas-Peucker algorithm: Recursively keep the vertex farthest away
+    // from the line segment between the kept vertices, as long as it is out of
+    // the tolerance. A stack is used instead of recursion to not overflow the
+    // call stack with big paths. Note that the start and end vertex (identical
+    // for closed paths) are always kept.
+    std::vector<bool> keep(path.size(), false);
+    keep.front() = true;
+    keep.back()  = true;
+    std::vector<std::pair<std::size_t, std::size_t>> sections;
+    sections.push_back(std::make_pair(0, path.size() - 1));
+    while (!sections.empty()) {
+      std::pair<std::size_t, std::size_t> section = sections.back();
+      sections.pop_back();
+      Point       start    = convert(path.at(section.first));
+      Point       end      = convert(path.at(section.second));
+      std::size_t farthest = section.first;
+      Length      maxDistance(0);
+      for (std::size_t i = section.first + 1; i < section.second; ++i) {
+        Length distance = *Toolbox::shortestDistanceBetweenPointAndLine(
+            convert(path.at(i)), start, end);
+        if (distance > maxDistance) {
+          maxDistance = distance;
+          farthest    = i;
+        }
+      }
+      if (maxDistance > *tolerance) {
+        keep[farthest] = true;
+        sections.push_back(std::make_pair(section.first, farthest));
+        sections.push_back(std::make_pair(farthest, section.second));
+      }
+    }
+    ClipperLib::Path result;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+      if (keep[i]) {
+        result.push_back(path.at(i));
+      }
+    }
+    path = result;
+  }
+}
+
 ClipperLib::Paths ClipperHelpers::flattenTree(
     const ClipperLib::PolyNode& node) {
   ClipperLib::Paths paths;
@@ -138,6 +204,49 @@ ClipperLib::Paths ClipperHelpers::flattenTree(
   return paths;
 }
 
+ClipperLib::IntRect ClipperHelpers::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  ClipperLib::IntRect rect = {0, 0, 0, 0};
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    const ClipperLib::IntPoint& p = path.at(i);
+    if (i == 0) {
+      rect = {p.X, p.Y, p.X, p.Y};
+    } else {
+      rect.left   = qMin(rect.left, p.X);
+      rect.top    = qMin(rect.top, p.Y);
+      rect.right  = qMax(rect.right, p.X);
+      rect.bottom = qMax(rect.bottom, p.Y);
+    }
+  }
+  return rect;
+}
+
+ClipperLib::IntRect ClipperHelpers::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect  = {0, 0, 0, 0};
+  bool                first = true;
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      if (first) {
+        rect  = {p.X, p.Y, p.X, p.Y};
+        first = false;
+      } else {
+        rect.left   = qMin(rect.left, p.X);
+        rect.top    = qMin(rect.top, p.Y);
+        rect.right  = qMax(rect.right, p.X);
+        rect.bottom = qMax(rect.bottom, p.Y);
+      }
+    }
+  }
+  return rect;
+}
+
+bool ClipperHelpers::boundsOverlap(const ClipperLib::IntRect& r1,
+                                   const ClipperLib::IntRect& r2) noexcept {
+  return (r1.left <= r2.right) && (r2.left <= r1.right) &&
+         (r1.top <= r2.bottom) && (r2.top <= r1.bottom);
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
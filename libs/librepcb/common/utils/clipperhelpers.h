@@ -55,13 +55,22 @@ public:
   static void unite(ClipperLib::Paths& paths);
   static void unite(ClipperLib::Paths& subject, const ClipperLib::Path& clip);
   static void unite(ClipperLib::Paths& subject, const ClipperLib::Paths& clip);
+  static std::unique_ptr<ClipperLib::PolyTree> uniteToTree(
+      const ClipperLib::Paths& paths);
   static std::unique_ptr<ClipperLib::PolyTree> intersect(
       const ClipperLib::Paths& subject, const ClipperLib::Paths& clip);
   static void subtract(ClipperLib::Paths&       subject,
                        const ClipperLib::Paths& clip);
   static void offset(ClipperLib::Paths& paths, const Length& offset,
                      const PositiveLength& maxArcTolerance);
+  static void simplify(ClipperLib::Paths&    paths,
+                       const UnsignedLength& tolerance) noexcept;
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+  static ClipperLib::IntRect getBounds(
+      const ClipperLib::Paths& paths) noexcept;
+  static bool boundsOverlap(const ClipperLib::IntRect& r1,
+                            const ClipperLib::IntRect& r2) noexcept;
 
   // Type Conversions
   static QVector<Path>     convert(const ClipperLib::Paths& paths) noexcept;
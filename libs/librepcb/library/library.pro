@@ -59,6 +59,7 @@ SOURCES += \
     library.cpp \
     librarybaseelement.cpp \
     librarybaseelementcheck.cpp \
+    librarybaseelementmetadata.cpp \
     libraryelement.cpp \
     libraryelementcheck.cpp \
     msg/libraryelementcheckmessage.cpp \
@@ -135,6 +136,7 @@ HEADERS += \
     library.h \
     librarybaseelement.h \
     librarybaseelementcheck.h \
+    librarybaseelementmetadata.h \
     libraryelement.h \
     libraryelementcheck.h \
     msg/libraryelementcheckmessage.h \
@@ -128,6 +128,32 @@ public:
                           ElementType::getShortElementName());
   }
 
+  /**
+   * @brief Check a library element directory and parse its main file
+   *
+   * Checks that the directory contains a version file which is not newer than
+   * the application, and optionally that the directory name is the UUID of
+   * the element.
+   *
+   * @param directory         The directory of the library element.
+   * @param dirnameMustBeUuid Whether the directory name must be the UUID.
+   * @param shortElementName  Short element name, e.g. "sym".
+   * @param longElementName   Long element name, e.g. "symbol".
+   * @param maxDepth          See librepcb::SExpression::parse().
+   * @param headerNames       See librepcb::SExpression::parse().
+   *
+   * @return The root node of the main file.
+   *
+   * @throw Exception if the directory is not a valid library element.
+   */
+  static SExpression readMainFile(const TransactionalDirectory& directory,
+                                  bool           dirnameMustBeUuid,
+                                  const QString& shortElementName,
+                                  const QString& longElementName,
+                                  int            maxDepth    = -1,
+                                  const QSet<QString>& headerNames =
+                                      QSet<QString>());
+
 protected:
   // Protected Methods
   virtual void cleanupAfterLoadingElementFromFile() noexcept;
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "librarybaseelementmetadata.h"
+
+#include "librarybaseelement.h"
+
+#include <librepcb/common/fileio/transactionaldirectory.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryBaseElementMetadata::LibraryBaseElementMetadata(
+    const TransactionalDirectory& directory, bool dirnameMustBeUuid,
+    const QString& shortElementName, const QString& longElementName)
+  : mRoot(),
+    mUuid(Uuid::createRandom()),  // just for initialization, will be
+                                  // overwritten
+    mVersion(Version::fromString(
+        "0.1")),  // just for initialization, will be overwritten
+    mIsDeprecated(false),
+    mNames(ElementName(
+        "unknown")),  // just for initialization, will be overwritten
+    mDescriptions(""),
+    mKeywords(""),
+    mCategories(),
+    mParentUuid() {
+  // Check the directory and parse the main file, but skip all lists nested
+  // deeper than the localized names (e.g. "(name (locale "de_DE") "Foo")")
+  // since they are not needed. The attributes are written at the beginning of
+  // the file, so the parser stops at the first other list (e.g. the pins of a
+  // symbol or the footprints of a package).
+  static const QSet<QString> headerNames = {
+      "name",     "description", "keywords",   "author",
+      "version",  "created",     "deprecated", "category",
+      "parent",   "component",   "package",    "schematic_only",
+      "default_value"};
+  mRoot = LibraryBaseElement::readMainFile(directory, dirnameMustBeUuid,
+                                           shortElementName, longElementName,
+                                           2, headerNames);  // can throw
+
+  // read attributes
+  mUuid         = mRoot.getChildByIndex(0).getValue<Uuid>();
+  mVersion      = mRoot.getValueByPath<Version>("version");
+  mAuthor       = mRoot.getValueByPath<QString>("author");
+  mCreated      = mRoot.getValueByPath<QDateTime>("created");
+  mIsDeprecated = mRoot.getValueByPath<bool>("deprecated");
+  mNames        = LocalizedNameMap(mRoot);
+  mDescriptions = LocalizedDescriptionMap(mRoot);
+  mKeywords     = LocalizedKeywordsMap(mRoot);
+  foreach (const SExpression& node, mRoot.getChildren("category")) {
+    mCategories.insert(node.getValueOfFirstChild<Uuid>());
+  }
+  if (const SExpression* node = mRoot.tryGetChildByPath("parent")) {
+    mParentUuid = node->getValueOfFirstChild<tl::optional<Uuid>>();
+  }
+}
+
+LibraryBaseElementMetadata::~LibraryBaseElementMetadata() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QStringList LibraryBaseElementMetadata::getAllAvailableLocales() const
+    noexcept {
+  QStringList list;
+  list.append(mNames.keys());
+  list.append(mDescriptions.keys());
+  list.append(mKeywords.keys());
+  list.removeDuplicates();
+  list.sort(Qt::CaseSensitive);
+  return list;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
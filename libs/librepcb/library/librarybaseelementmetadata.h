@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYBASEELEMENTMETADATA_H
+#define LIBREPCB_LIBRARY_LIBRARYBASEELEMENTMETADATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/serializablekeyvaluemap.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/version.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class TransactionalDirectory;
+
+namespace library {
+
+/*******************************************************************************
+ *  Class LibraryBaseElementMetadata
+ ******************************************************************************/
+
+/**
+ * @brief Lightweight reader for the metadata of a library element
+ *
+ * Reads only the attributes which are needed to index a library element (UUID,
+ * version, names, categories etc.) without creating the whole element, i.e.
+ * without loading footprints, polygons, pads and so on. Only the header of the
+ * main file is parsed, and deeply nested lists are skipped, see
+ * librepcb::SExpression::parse().
+ *
+ * The same validity checks as in the constructor of
+ * librepcb::library::LibraryBaseElement are performed (see
+ * librepcb::library::LibraryBaseElement::readMainFile()) and the same mandatory
+ * attributes are read, so an element which can be read with this class can
+ * also be opened (unless its element specific content is invalid).
+ *
+ * @note This class does not derive from QObject, thus it can safely be created
+ *       in worker threads.
+ */
+class LibraryBaseElementMetadata final {
+public:
+  // Constructors / Destructor
+  LibraryBaseElementMetadata() = delete;
+  LibraryBaseElementMetadata(const LibraryBaseElementMetadata& other) = delete;
+  LibraryBaseElementMetadata(const TransactionalDirectory& directory,
+                             bool                          dirnameMustBeUuid,
+                             const QString&                shortElementName,
+                             const QString&                longElementName);
+  ~LibraryBaseElementMetadata() noexcept;
+
+  // Getters
+  const Uuid&      getUuid() const noexcept { return mUuid; }
+  const Version&   getVersion() const noexcept { return mVersion; }
+  const QString&   getAuthor() const noexcept { return mAuthor; }
+  const QDateTime& getCreated() const noexcept { return mCreated; }
+  bool             isDeprecated() const noexcept { return mIsDeprecated; }
+  const LocalizedNameMap&        getNames() const noexcept { return mNames; }
+  const LocalizedDescriptionMap& getDescriptions() const noexcept {
+    return mDescriptions;
+  }
+  const LocalizedKeywordsMap& getKeywords() const noexcept { return mKeywords; }
+  QStringList                 getAllAvailableLocales() const noexcept;
+  const QSet<Uuid>& getCategories() const noexcept { return mCategories; }
+  const tl::optional<Uuid>& getParentUuid() const noexcept {
+    return mParentUuid;
+  }
+
+  /**
+   * @brief Get an element specific attribute
+   *
+   * @param path  Path of the attribute, see librepcb::SExpression. Only the
+   *              attributes of the header (e.g. "component" of a device) are
+   *              available.
+   *
+   * @return The deserialized value.
+   *
+   * @throw Exception if the attribute does not exist or is invalid.
+   */
+  template <typename T>
+  T getValueByPath(const QString& path) const {
+    return mRoot.getValueByPath<T>(path);  // can throw
+  }
+
+  // Operator Overloadings
+  LibraryBaseElementMetadata& operator=(
+      const LibraryBaseElementMetadata& rhs) = delete;
+
+private:  // Data
+  SExpression             mRoot;  ///< Header of the main file
+  Uuid                    mUuid;
+  Version                 mVersion;
+  QString                 mAuthor;
+  QDateTime               mCreated;
+  bool                    mIsDeprecated;
+  LocalizedNameMap        mNames;
+  LocalizedDescriptionMap mDescriptions;
+  LocalizedKeywordsMap    mKeywords;
+  QSet<Uuid>              mCategories;  ///< Empty for categories
+  tl::optional<Uuid>      mParentUuid;  ///< Only set for categories
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
+
+#endif  // LIBREPCB_LIBRARY_LIBRARYBASEELEMENTMETADATA_H
@@ -30,6 +30,7 @@
 #include "boardairwiresbuilder.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardplanefragmentsbuilder.h"
 #include "boardselectionquery.h"
 #include "boardusersettings.h"
 #include "items/bi_airwire.h"
@@ -57,6 +58,7 @@
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/pkg/footprint.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -79,9 +81,14 @@ Board::Board(const Board&                            other,
     mProject(other.getProject()),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mIsModified(true),
+    mAirWiresRebuildJobOutdated(false),
     mUuid(Uuid::createRandom()),
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
+  // must be done before loading any items since they may schedule rebuilds
+  initBackgroundJobs();
+
   try {
     mGraphicsScene.reset(new GraphicsScene());
 
@@ -156,6 +163,8 @@ Board::Board(const Board&                            other,
             &Board::updateErcMessages);
     connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
             &Board::updateErcMessages);
+    connect(&mProject.getCircuit(), &Circuit::netSignalRemoved, this,
+            &Board::netSignalRemoved);
   } catch (...) {
     // free the allocated memory in the reverse order of their allocation...
     qDeleteAll(mErcMsgListUnplacedComponentInstances);
@@ -185,14 +194,19 @@ Board::Board(const Board&                            other,
 }
 
 Board::Board(Project&                                project,
-             std::unique_ptr<TransactionalDirectory> directory, bool create,
-             const QString& newName)
+             std::unique_ptr<TransactionalDirectory> directory,
+             const SExpression& root, bool create, const QString& newName)
   : QObject(&project),
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mIsModified(true),
+    mAirWiresRebuildJobOutdated(false),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
+  // must be done before loading any items since they may schedule rebuilds
+  initBackgroundJobs();
+
   try {
     mGraphicsScene.reset(new GraphicsScene());
 
@@ -227,9 +241,6 @@ Board::Board(Project&                                project,
                       Path::rect(Point(0, 0), Point(100000000, 80000000)));
       mPolygons.append(new BI_Polygon(*this, polygon));
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
-
       // the board seems to be ready to open, so we will create all needed
       // objects
 
@@ -274,7 +285,7 @@ Board::Board(Project&                                project,
       }
 
       // Load all device instances
-      foreach (const SExpression& node, root.getChildren("device")) {
+      root.forEachChild("device", [this](const SExpression& node) {
         BI_Device* device = new BI_Device(*this, node);
         if (getDeviceInstanceByComponentUuid(
                 device->getComponentInstanceUuid())) {
@@ -285,10 +296,10 @@ Board::Board(Project&                                project,
                   .arg(device->getComponentInstanceUuid().toStr()));
         }
         mDeviceInstances.insert(device->getComponentInstanceUuid(), device);
-      }
+      });
 
       // Load all netsegments
-      foreach (const SExpression& node, root.getChildren("netsegment")) {
+      root.forEachChild("netsegment", [this](const SExpression& node) {
         BI_NetSegment* netsegment = new BI_NetSegment(*this, node);
         if (getNetSegmentByUuid(netsegment->getUuid())) {
           throw RuntimeError(
@@ -297,31 +308,31 @@ Board::Board(Project&                                project,
                   .arg(netsegment->getUuid().toStr()));
         }
         mNetSegments.append(netsegment);
-      }
+      });
 
       // Load all planes
-      foreach (const SExpression& node, root.getChildren("plane")) {
+      root.forEachChild("plane", [this](const SExpression& node) {
         BI_Plane* plane = new BI_Plane(*this, node);
         mPlanes.append(plane);
-      }
+      });
 
       // Load all polygons
-      foreach (const SExpression& node, root.getChildren("polygon")) {
+      root.forEachChild("polygon", [this](const SExpression& node) {
         BI_Polygon* polygon = new BI_Polygon(*this, node);
         mPolygons.append(polygon);
-      }
+      });
 
       // Load all stroke texts
-      foreach (const SExpression& node, root.getChildren("stroke_text")) {
+      root.forEachChild("stroke_text", [this](const SExpression& node) {
         BI_StrokeText* text = new BI_StrokeText(*this, node);
         mStrokeTexts.append(text);
-      }
+      });
 
       // Load all holes
-      foreach (const SExpression& node, root.getChildren("hole")) {
+      root.forEachChild("hole", [this](const SExpression& node) {
         BI_Hole* hole = new BI_Hole(*this, node);
         mHoles.append(hole);
-      }
+      });
     }
 
     rebuildAllPlanes();
@@ -336,6 +347,8 @@ Board::Board(Project&                                project,
             &Board::updateErcMessages);
     connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
             &Board::updateErcMessages);
+    connect(&mProject.getCircuit(), &Circuit::netSignalRemoved, this,
+            &Board::netSignalRemoved);
   } catch (...) {
     // free the allocated memory in the reverse order of their allocation...
     qDeleteAll(mErcMsgListUnplacedComponentInstances);
@@ -367,6 +380,9 @@ Board::Board(Project&                                project,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  // a running plane rebuild doesn't access the board, just abort it
+  if (mPlanesRebuildJob) mPlanesRebuildJob->cancel();
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -409,23 +425,30 @@ bool Board::isEmpty() const noexcept {
 }
 
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QPointF         scenePosPx = pos.toPxQPointF();
+  QList<BI_Base*> candidates = getItemCandidatesAtScenePos(pos);
   QList<BI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
   // vias
-  foreach (BI_Via* via, getViasAtScenePos(pos, nullptr)) { list.append(via); }
+  foreach (BI_Via* via, filterViasAtScenePos(candidates, pos, nullptr)) {
+    list.append(via);
+  }
   // netpoints
   foreach (BI_NetPoint* netpoint,
-           getNetPointsAtScenePos(pos, nullptr, nullptr)) {
+           filterNetPointsAtScenePos(candidates, pos, nullptr, nullptr)) {
     list.append(netpoint);
   }
   // netlines
-  foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
+  foreach (BI_NetLine* netline,
+           filterNetLinesAtScenePos(candidates, pos, nullptr, nullptr)) {
     list.append(netline);
   }
-  // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
+  // footprints & pads (bottom most device first since most of its items are
+  // prepended to the list)
+  const QList<BI_Device*> devices = getDevicesOfItems(candidates);
+  for (int i = devices.count() - 1; i >= 0; --i) {
+    BI_Device* device = devices.at(i);
     BI_Footprint& footprint = device->getFootprint();
     if (footprint.isSelectable() &&
         footprint.getGrabAreaScenePx().contains(scenePosPx)) {
@@ -457,77 +480,50 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // planes
-  foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
-        planes->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(planes);
-    }
-  }
+  list.append(
+      filterItemsAtScenePos(candidates, pos, BI_Base::Type_t::Plane));
   // polygons
-  foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelectable() &&
-        polygon->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(polygon);
-    }
-  }
-  // texts
-  foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
-        text->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(text);
+  list.append(
+      filterItemsAtScenePos(candidates, pos, BI_Base::Type_t::Polygon));
+  // texts (the texts of footprints are already added above)
+  foreach (BI_Base* item, filterItemsAtScenePos(candidates, pos,
+                                                BI_Base::Type_t::StrokeText)) {
+    if (!static_cast<BI_StrokeText*>(item)->getFootprint()) {
+      list.append(item);
     }
   }
   // holes
-  foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelectable() &&
-        hole->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(hole);
-    }
-  }
+  list.append(filterItemsAtScenePos(candidates, pos, BI_Base::Type_t::Hole));
   return list;
 }
 
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
-  QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
-    }
-  }
-  return list;
+  return filterViasAtScenePos(getItemCandidatesAtScenePos(pos), pos,
+                              netsignal);
 }
 
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
-  QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
-    }
-  }
-  return list;
+  return filterNetPointsAtScenePos(getItemCandidatesAtScenePos(pos), pos,
+                                   layer, netsignal);
 }
 
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
-  QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
-    }
-  }
-  return list;
+  return filterNetLinesAtScenePos(getItemCandidatesAtScenePos(pos), pos,
+                                  layer, netsignal);
 }
 
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
+  foreach (BI_Device* device,
+           getDevicesOfItems(getItemCandidatesAtScenePos(pos))) {
     foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
       if (pad->isSelectable() &&
           pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
@@ -565,6 +561,7 @@ QList<BI_Base*> Board::getAllItems() const noexcept {
 
 void Board::setGridProperties(const GridProperties& grid) noexcept {
   *mGridProperties = grid;
+  notifyModified();
 }
 
 /*******************************************************************************
@@ -666,12 +663,20 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  std::sort(planes.begin(), planes.end(),
-            [](const BI_Plane* p1, const BI_Plane* p2) {
-              return !(*p1 < *p2);
-            });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  // a scheduled or running background rebuild is obsolete now
+  mPlanesRebuildTimer.stop();
+  if (mPlanesRebuildJob) mPlanesRebuildJob->cancel();
+
+  std::shared_ptr<BoardPlaneFragmentsBuilder> builder =
+      std::make_shared<BoardPlaneFragmentsBuilder>(
+          *this, mPlaneFragmentsBuilder.get());
+  applyPlaneFragments(builder->buildFragments());
+  mPlaneFragmentsBuilder = builder;
+}
+
+void Board::schedulePlanesRebuild() noexcept {
+  if (mPlanesRebuildJob) mPlanesRebuildJob->cancel();  // result is outdated
+  mPlanesRebuildTimer.start();
 }
 
 /*******************************************************************************
@@ -741,32 +746,45 @@ void Board::removeHole(BI_Hole& hole) {
  *  AirWire Methods
  ******************************************************************************/
 
+void Board::scheduleAirWiresRebuild(NetSignal* netsignal) noexcept {
+  mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
+  triggerAirWiresRebuild();
+}
+
 void Board::triggerAirWiresRebuild() noexcept {
+  if ((!mScheduledNetSignalsForAirWireRebuild.isEmpty()) &&
+      (!mAirWiresRebuildTimer.isActive())) {
+    // Note: The timer is not restarted if it is already active, otherwise
+    // continuous modifications (e.g. dragging) would delay the rebuild
+    // until the modifications are finished.
+    mAirWiresRebuildTimer.start();
+  }
+}
+
+void Board::forceAirWiresRebuild() noexcept {
+  mScheduledNetSignalsForAirWireRebuild.unite(
+      Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
+  mScheduledNetSignalsForAirWireRebuild.unite(Toolbox::toSet(mAirWires.keys()));
   if (!mIsAddedToProject) {
     return;
   }
 
+  // the result of a running job would overwrite the new airwires, and the
+  // job is still using the builders
+  mAirWiresRebuildTimer.stop();
+  if (mAirWiresRebuildWatcher.isRunning()) {
+    mAirWiresRebuildWatcher.waitForFinished();
+    mAirWiresRebuildJobOutdated = true;
+  }
+
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
-      }
-
-      if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
-        }
+      QVector<QPair<Point, Point>> airwires;
+      if (std::shared_ptr<BoardAirWiresBuilder> builder =
+              prepareAirWiresBuilder(netsignal)) {
+        airwires = builder->buildAirWires();
       }
+      applyAirWires(netsignal, airwires);  // can throw
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
   } catch (const std::exception&
@@ -775,13 +793,6 @@ void Board::triggerAirWiresRebuild() noexcept {
   }
 }
 
-void Board::forceAirWiresRebuild() noexcept {
-  mScheduledNetSignalsForAirWireRebuild.unite(
-      Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
-  mScheduledNetSignalsForAirWireRebuild.unite(Toolbox::toSet(mAirWires.keys()));
-  triggerAirWiresRebuild();
-}
-
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -797,7 +808,9 @@ void Board::addToProject() {
     item->addToBoard();  // can throw
     sgl.add([item]() { item->removeFromBoard(); });
   }
+  // The board directory might have been removed by a save in the meantime.
   mIsAddedToProject = true;
+  mIsModified       = true;
   forceAirWiresRebuild();
   updateErcMessages();
   sgl.dismiss();
@@ -821,10 +834,13 @@ void Board::removeFromProject() {
 
 void Board::save() {
   if (mIsAddedToProject) {
-    // save board file
-    SExpression brdDoc(serializeToDomElement("librepcb_board"));  // can throw
-    mDirectory->write(getFilePath().getFilename(),
-                      brdDoc.toByteArray());  // can throw
+    // save board file, but only if it was modified since the last save
+    if (mIsModified) {
+      SExpression brdDoc(serializeToDomElement("librepcb_board"));  // can throw
+      mDirectory->write(getFilePath().getFilename(),
+                        brdDoc.toByteArray());  // can throw
+      mIsModified = false;
+    }
 
     // save user settings
     SExpression usrDoc(mUserSettings->serializeToDomElement(
@@ -835,6 +851,14 @@ void Board::save() {
   }
 }
 
+void Board::notifyItemModified(BI_Base& item) noexcept {
+  // air wires are not saved in the board file
+  if (item.getType() != BI_Base::Type_t::AirWire) {
+    notifyModified();
+  }
+  emit itemModified(item);
+}
+
 void Board::print(QPrinter& printer) {
   clearSelection();
 
@@ -953,6 +977,24 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const
  *  Private Methods
  ******************************************************************************/
 
+void Board::initBackgroundJobs() noexcept {
+  // rebuild airwires in background, see triggerAirWiresRebuild()
+  mAirWiresRebuildTimer.setSingleShot(true);
+  mAirWiresRebuildTimer.setInterval(20);
+  connect(&mAirWiresRebuildTimer, &QTimer::timeout, this,
+          &Board::startAirWiresRebuild);
+  connect(&mAirWiresRebuildWatcher, &QFutureWatcherBase::finished, this,
+          &Board::airWiresRebuildFinished);
+
+  // rebuild planes in background, see schedulePlanesRebuild()
+  mPlanesRebuildTimer.setSingleShot(true);
+  mPlanesRebuildTimer.setInterval(300);
+  connect(&mPlanesRebuildTimer, &QTimer::timeout, this,
+          &Board::startPlanesRebuild);
+  connect(&mPlanesRebuildWatcher, &QFutureWatcherBase::finished, this,
+          &Board::planesRebuildFinished);
+}
+
 void Board::updateIcon() noexcept {
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
@@ -982,6 +1024,262 @@ void Board::serialize(SExpression& root) const {
   root.appendLineBreak();
 }
 
+QList<BI_Base*> Board::getItemCandidatesAtScenePos(const Point& pos) const
+    noexcept {
+  // The graphics scene maintains a spatial index (BSP tree) of all graphics
+  // items which is updated whenever an item is added, removed, moved or
+  // changes its geometry. So instead of iterating over all board items, use
+  // this index to determine the items whose bounding rect contains the
+  // position. Callers still need to check the exact grab area.
+  QList<BI_Base*> items;
+  foreach (const QGraphicsItem* graphicsItem,
+           mGraphicsScene->items(pos.toPxQPointF(),
+                                 Qt::IntersectsItemBoundingRect,
+                                 Qt::DescendingOrder)) {
+    BI_Base* item = BI_Base::fromGraphicsItem(*graphicsItem);
+    if (item && (&item->getBoard() == this) && (!items.contains(item))) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
+QList<BI_Base*> Board::filterItemsAtScenePos(const QList<BI_Base*>& items,
+                                             const Point&           pos,
+                                             BI_Base::Type_t type) const
+    noexcept {
+  QList<BI_Base*> list;
+  foreach (BI_Base* item, items) {
+    if ((item->getType() == type) && item->isSelectable() &&
+        item->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(item);
+    }
+  }
+  return list;
+}
+
+QList<BI_Via*> Board::filterViasAtScenePos(const QList<BI_Base*>& items,
+                                           const Point&           pos,
+                                           const NetSignal* netsignal) const
+    noexcept {
+  QList<BI_Via*> list;
+  foreach (BI_Base* item, items) {
+    if (item->getType() != BI_Base::Type_t::Via) continue;
+    BI_Via* via = static_cast<BI_Via*>(item);
+    if (via->isSelectable() &&
+        via->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+        ((!netsignal) || (&via->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(via);
+    }
+  }
+  return list;
+}
+
+QList<BI_NetPoint*> Board::filterNetPointsAtScenePos(
+    const QList<BI_Base*>& items, const Point& pos, const GraphicsLayer* layer,
+    const NetSignal* netsignal) const noexcept {
+  QList<BI_NetPoint*> list;
+  foreach (BI_Base* item, items) {
+    if (item->getType() != BI_Base::Type_t::NetPoint) continue;
+    BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+    if (netpoint->isSelectable() &&
+        netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+        ((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+        ((!netsignal) ||
+         (&netpoint->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(netpoint);
+    }
+  }
+  return list;
+}
+
+QList<BI_NetLine*> Board::filterNetLinesAtScenePos(
+    const QList<BI_Base*>& items, const Point& pos, const GraphicsLayer* layer,
+    const NetSignal* netsignal) const noexcept {
+  QList<BI_NetLine*> list;
+  foreach (BI_Base* item, items) {
+    if (item->getType() != BI_Base::Type_t::NetLine) continue;
+    BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+    if (netline->isSelectable() &&
+        netline->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+        ((!layer) || (&netline->getLayer() == layer)) &&
+        ((!netsignal) ||
+         (&netline->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(netline);
+    }
+  }
+  return list;
+}
+
+QList<BI_Device*> Board::getDevicesOfItems(const QList<BI_Base*>& items) const
+    noexcept {
+  QList<BI_Device*> devices;  // in stacking order, top most first
+  foreach (BI_Base* item, items) {
+    BI_Device* device = nullptr;
+    if (item->getType() == BI_Base::Type_t::Footprint) {
+      device = &static_cast<BI_Footprint*>(item)->getDeviceInstance();
+    } else if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      device = &static_cast<BI_FootprintPad*>(item)
+                    ->getFootprint()
+                    .getDeviceInstance();
+    } else if (item->getType() == BI_Base::Type_t::StrokeText) {
+      if (BI_Footprint* footprint =
+              static_cast<BI_StrokeText*>(item)->getFootprint()) {
+        device = &footprint->getDeviceInstance();
+      }
+    }
+    if (device && (!devices.contains(device))) {
+      devices.append(device);
+    }
+  }
+  return devices;
+}
+
+std::shared_ptr<BoardAirWiresBuilder> Board::prepareAirWiresBuilder(
+    NetSignal* netsignal) noexcept {
+  if ((!netsignal) || (!netsignal->isAddedToCircuit())) {
+    mAirWiresBuilders.remove(netsignal);
+    return nullptr;
+  }
+  std::shared_ptr<BoardAirWiresBuilder>& builder = mAirWiresBuilders[netsignal];
+  if (!builder) {
+    builder = std::make_shared<BoardAirWiresBuilder>();
+  }
+  builder->updateSnapshot(*this, *netsignal);
+  return builder;
+}
+
+void Board::startAirWiresRebuild() noexcept {
+  if ((!mIsAddedToProject) || mAirWiresRebuildWatcher.isRunning()) {
+    return;  // will be restarted when the running job is finished
+  }
+
+  // The snapshots of the net signals are taken in this thread, only the
+  // airwires calculation is done in a worker thread. Net signals which are
+  // not scheduled keep their airwires.
+  // The jobs are identified by UUID since the net signals might be removed
+  // from the circuit (and deleted) while the job is running.
+  QList<std::pair<Uuid, std::shared_ptr<BoardAirWiresBuilder>>> jobs;
+  foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
+    if (std::shared_ptr<BoardAirWiresBuilder> builder =
+            prepareAirWiresBuilder(netsignal)) {
+      jobs.append(std::make_pair(netsignal->getUuid(), builder));
+    }
+  }
+  mScheduledNetSignalsForAirWireRebuild.clear();
+  mAirWiresRebuildJobOutdated = false;
+  mAirWiresRebuildWatcher.setFuture(QtConcurrent::run([jobs]() {
+    QHash<Uuid, QVector<QPair<Point, Point>>> result;
+    for (const auto& job : jobs) {
+      try {
+        result.insert(job.first, job.second->buildAirWires());
+      } catch (const std::exception& e) {
+        qCritical() << "Failed to build airwires:" << e.what();
+      }
+    }
+    return result;
+  }));
+}
+
+void Board::airWiresRebuildFinished() noexcept {
+  if (mIsAddedToProject && (!mAirWiresRebuildJobOutdated)) {
+    try {
+      const QHash<Uuid, QVector<QPair<Point, Point>>> result =
+          mAirWiresRebuildWatcher.result();
+      for (auto it = result.constBegin(); it != result.constEnd(); ++it) {
+        // skip net signals which were removed in the meantime
+        if (NetSignal* netsignal =
+                mProject.getCircuit().getNetSignalByUuid(it.key())) {
+          applyAirWires(netsignal, it.value());  // can throw
+        }
+      }
+    } catch (const std::exception& e) {
+      qCritical() << "Failed to add airwires:" << e.what();
+    }
+    emit airWiresRebuilt();
+  }
+  mAirWiresRebuildJobOutdated = false;
+  triggerAirWiresRebuild();  // net signals modified in the meantime
+}
+
+void Board::applyAirWires(NetSignal*                          netsignal,
+                          const QVector<QPair<Point, Point>>& airwires) {
+  // remove old airwires
+  while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
+    airWire->removeFromBoard();  // can throw
+    delete airWire;
+  }
+
+  // add new airwires
+  if (netsignal && netsignal->isAddedToCircuit()) {
+    foreach (const auto& points, airwires) {
+      QScopedPointer<BI_AirWire> airWire(
+          new BI_AirWire(*this, *netsignal, points.first, points.second));
+      airWire->addToBoard();  // can throw
+      mAirWires.insertMulti(netsignal, airWire.take());
+    }
+  }
+}
+
+void Board::netSignalRemoved(NetSignal& netsignal) noexcept {
+  // the net signal might be deleted, so don't keep any reference to it
+  mScheduledNetSignalsForAirWireRebuild.remove(&netsignal);
+  mAirWiresBuilders.remove(&netsignal);
+  try {
+    while (BI_AirWire* airWire = mAirWires.take(&netsignal)) {
+      QScopedPointer<BI_AirWire> airWireGuard(airWire);
+      if (airWire->isAddedToBoard()) {
+        airWire->removeFromBoard();  // can throw
+      }
+    }
+  } catch (const Exception& e) {
+    qCritical() << "Failed to remove airwires:" << e.getMsg();
+  }
+}
+
+void Board::startPlanesRebuild() noexcept {
+  if (mPlanesRebuildJob) {
+    // an aborted job is still running, try again when it is finished
+    mPlanesRebuildTimer.start();
+    return;
+  }
+
+  // The snapshot of the board is taken in this thread, only the fill itself is
+  // done in a worker thread.
+  std::shared_ptr<BoardPlaneFragmentsBuilder> job =
+      std::make_shared<BoardPlaneFragmentsBuilder>(
+          *this, mPlaneFragmentsBuilder.get());
+  mPlanesRebuildJob = job;
+  mPlanesRebuildWatcher.setFuture(
+      QtConcurrent::run([job]() { return job->buildFragments(); }));
+}
+
+void Board::planesRebuildFinished() noexcept {
+  std::shared_ptr<BoardPlaneFragmentsBuilder> job = mPlanesRebuildJob;
+  mPlanesRebuildJob.reset();
+  if ((!job) || job->isCanceled()) {
+    return;  // outdated result
+  }
+
+  applyPlaneFragments(mPlanesRebuildWatcher.result());
+  mPlaneFragmentsBuilder = job;
+  triggerAirWiresRebuild();
+  emit planesRebuilt();
+}
+
+void Board::applyPlaneFragments(
+    const QHash<Uuid, QVector<Path>>& fragments) noexcept {
+  foreach (BI_Plane* plane, mPlanes) {
+    auto it = fragments.find(plane->getUuid());
+    if ((it != fragments.end()) && (*it != plane->getFragments())) {
+      plane->setFragments(*it);
+      // Note: Plane fragments are not saved in the board file, so don't use
+      // notifyItemModified() to not mark the board as modified.
+      emit itemModified(*plane);
+    }
+  }
+}
+
 void Board::updateErcMessages() noexcept {
   // type: UnplacedComponent (ComponentInstances without DeviceInstance)
   if (mIsAddedToProject) {
@@ -1023,7 +1321,8 @@ void Board::updateErcMessages() noexcept {
 Board* Board::create(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
                      const ElementName&                      name) {
-  return new Board(project, std::move(directory), true, *name);
+  return new Board(project, std::move(directory), SExpression(), true,
+                   *name);
 }
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../erc/if_ercmsgprovider.h"
+#include "items/bi_base.h"
 
 #include <librepcb/common/attributes/attributeprovider.h>
 #include <librepcb/common/elementname.h>
@@ -31,6 +32,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/transactionaldirectory.h>
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/uuid.h>
 
@@ -56,7 +58,6 @@ namespace project {
 class NetSignal;
 class Project;
 class BI_Device;
-class BI_Base;
 class BI_FootprintPad;
 class BI_Via;
 class BI_NetSegment;
@@ -71,6 +72,8 @@ class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardAirWiresBuilder;
+class BoardPlaneFragmentsBuilder;
 
 /*******************************************************************************
  *  Class Board
@@ -124,8 +127,9 @@ public:
   Board(const Board& other) = delete;
   Board(const Board& other, std::unique_ptr<TransactionalDirectory> directory,
         const ElementName& name);
-  Board(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Board(project, std::move(directory), false, QString()) {}
+  Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+        const SExpression& root)
+    : Board(project, std::move(directory), root, false, QString()) {}
   ~Board() noexcept;
 
   // Getters: General
@@ -199,6 +203,17 @@ public:
   void                    removePlane(BI_Plane& plane);
   void                    rebuildAllPlanes() noexcept;
 
+  /**
+   * @brief Rebuild all planes in the background
+   *
+   * The rebuild is started after there were no more calls to this method for
+   * a short time. The planes are filled in a worker thread, and the fragments
+   * are updated as soon as it is finished. A running rebuild is aborted and
+   * its result discarded when this method (or #rebuildAllPlanes()) is called
+   * again since the result is outdated.
+   */
+  void schedulePlanesRebuild() noexcept;
+
   // Polygon Methods
   const QList<BI_Polygon*>& getPolygons() const noexcept { return mPolygons; }
   void                      addPolygon(BI_Polygon& polygon);
@@ -218,12 +233,41 @@ public:
 
   // AirWire Methods
   QList<BI_AirWire*> getAirWires() const noexcept { return mAirWires.values(); }
-  void               scheduleAirWiresRebuild(NetSignal* netsignal) noexcept {
-    mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
-  }
+  void               scheduleAirWiresRebuild(NetSignal* netsignal) noexcept;
+
+  /**
+   * @brief Rebuild the airwires of all scheduled net signals in background
+   *
+   * Multiple calls within a short time are coalesced into a single rebuild.
+   * The airwires are calculated in a worker thread and added to the board as
+   * soon as they are available.
+   */
   void triggerAirWiresRebuild() noexcept;
+
+  /**
+   * @brief Immediately rebuild the airwires of all net signals
+   */
   void forceAirWiresRebuild() noexcept;
 
+  /**
+   * @brief Notify that an item was added, removed or modified
+   *
+   * This is called by the board items themselves, see #itemModified(). Except
+   * for air wires, it also marks the board as modified (see #notifyModified()).
+   *
+   * @param item    The modified item
+   */
+  void notifyItemModified(BI_Base& item) noexcept;
+
+  /**
+   * @brief Notify that the content of the board file was modified
+   *
+   * Must be called on every modification which is not done through a board
+   * item, e.g. of the design rules. #save() only serializes the board file if
+   * the board was modified since the last save.
+   */
+  void notifyModified() noexcept { mIsModified = true; }
+
   // General Methods
   void addToProject();
   void removeFromProject();
@@ -278,11 +322,56 @@ signals:
   void deviceAdded(BI_Device& comp);
   void deviceRemoved(BI_Device& comp);
 
+  /**
+   * @brief An item was added to, removed from or modified on this board
+   *
+   * Emitted whenever the geometry, the layer or the net signal of an item
+   * changed, which allows to update only the affected areas of the board
+   * instead of the whole board.
+   *
+   * @param item    The modified item (may be removed from the board already)
+   */
+  void itemModified(BI_Base& item);
+
+  /// The fragments of the planes were rebuilt in the background
+  void planesRebuilt();
+
+  /// The airwires were rebuilt in the background
+  void airWiresRebuilt();
+
 private:
   Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-        bool create, const QString& newName);
+        const SExpression& root, bool create, const QString& newName);
+  void initBackgroundJobs() noexcept;
   void updateIcon() noexcept;
   void updateErcMessages() noexcept;
+  QList<BI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
+  QList<BI_Base*> filterItemsAtScenePos(const QList<BI_Base*>& items,
+                                        const Point&           pos,
+                                        BI_Base::Type_t type) const noexcept;
+  QList<BI_Via*>  filterViasAtScenePos(const QList<BI_Base*>& items,
+                                       const Point&           pos,
+                                       const NetSignal* netsignal) const
+      noexcept;
+  QList<BI_NetPoint*> filterNetPointsAtScenePos(
+      const QList<BI_Base*>& items, const Point& pos,
+      const GraphicsLayer* layer, const NetSignal* netsignal) const noexcept;
+  QList<BI_NetLine*> filterNetLinesAtScenePos(
+      const QList<BI_Base*>& items, const Point& pos,
+      const GraphicsLayer* layer, const NetSignal* netsignal) const noexcept;
+  QList<BI_Device*> getDevicesOfItems(const QList<BI_Base*>& items) const
+      noexcept;
+  std::shared_ptr<BoardAirWiresBuilder> prepareAirWiresBuilder(
+      NetSignal* netsignal) noexcept;
+  void startAirWiresRebuild() noexcept;
+  void airWiresRebuildFinished() noexcept;
+  void applyAirWires(NetSignal*                          netsignal,
+                     const QVector<QPair<Point, Point>>& airwires);
+  void netSignalRemoved(NetSignal& netsignal) noexcept;
+  void startPlanesRebuild() noexcept;
+  void planesRebuildFinished() noexcept;
+  void applyPlaneFragments(
+      const QHash<Uuid, QVector<Path>>& fragments) noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -291,6 +380,7 @@ private:
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool                                    mIsAddedToProject;
+  bool                                    mIsModified;  ///< see #save()
 
   QScopedPointer<GraphicsScene>                  mGraphicsScene;
   QScopedPointer<BoardLayerStack>                mLayerStack;
@@ -300,6 +390,19 @@ private:
   QScopedPointer<BoardUserSettings>              mUserSettings;
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  QFutureWatcher<QHash<Uuid, QVector<QPair<Point, Point>>>>
+         mAirWiresRebuildWatcher;
+  QTimer mAirWiresRebuildTimer;
+  bool   mAirWiresRebuildJobOutdated;  ///< Discard result of running job
+
+  /// One builder per net signal, kept to update the airwires incrementally
+  QHash<NetSignal*, std::shared_ptr<BoardAirWiresBuilder>> mAirWiresBuilders;
+
+  /// The builder of the last plane rebuild, to reuse unchanged plane fragments
+  std::shared_ptr<BoardPlaneFragmentsBuilder> mPlaneFragmentsBuilder;
+  std::shared_ptr<BoardPlaneFragmentsBuilder> mPlanesRebuildJob;  ///< Running
+  QFutureWatcher<QHash<Uuid, QVector<Path>>>  mPlanesRebuildWatcher;
+  QTimer                                      mPlanesRebuildTimer;
 
   // Attributes
   Uuid        mUuid;
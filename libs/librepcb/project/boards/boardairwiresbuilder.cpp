@@ -36,6 +36,7 @@
 
 #include <librepcb/common/algorithm/airwiresbuilder.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/toolbox.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
 #include <QtCore>
@@ -50,9 +51,7 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardAirWiresBuilder::BoardAirWiresBuilder(const Board&     board,
-                                           const NetSignal& netsignal) noexcept
-  : mBoard(board), mNetSignal(netsignal) {
+BoardAirWiresBuilder::BoardAirWiresBuilder() noexcept : mRemovedPoints(0) {
 }
 
 BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
@@ -62,80 +61,158 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
  *  General Methods
  ******************************************************************************/
 
-QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder                       builder;
-  QHash<int, std::pair<Point, QString>> pointLayerMap;  // ID -> (point, layer)
-  QHash<const BI_NetLineAnchor*, int>   anchorMap;      // anchor -> ID
+void BoardAirWiresBuilder::updateSnapshot(const Board&     board,
+                                          const NetSignal& netsignal) noexcept {
+  mAnchors.clear();
+  mTraces.clear();
+  mPlanes.clear();
+  QHash<const BI_NetLineAnchor*, int> anchorMap;  // anchor -> index
 
   // pads
-  foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
+  foreach (ComponentSignalInstance* cmpSig, netsignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
-      if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int          id  = builder.addPoint(pos);
-      pointLayerMap[id] =
-          std::make_pair(pos, (pad->getLibPad().getBoardSide() ==
-                               library::FootprintPad::BoardSide::THT)
-                                  ? QString()  // on all layers
-                                  : pad->getLayerName());
-      anchorMap[pad] = id;
+      if (&pad->getBoard() != &board) continue;
+      anchorMap[pad] = mAnchors.count();
+      mAnchors.append(
+          std::make_pair(pad->getPosition(),
+                         (pad->getLibPad().getBoardSide() ==
+                          library::FootprintPad::BoardSide::THT)
+                             ? QString()  // on all layers
+                             : pad->getLayerName()));
     }
   }
 
   // vias, netpoints, netlines
-  foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
     Q_ASSERT(netsegment);
-    if (&netsegment->getBoard() != &mBoard) continue;
+    if (&netsegment->getBoard() != &board) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      const Point& pos  = via->getPosition();
-      int          id   = builder.addPoint(pos);
-      pointLayerMap[id] = std::make_pair(pos, QString());  // on all layers
-      anchorMap[via]    = id;
+      anchorMap[via] = mAnchors.count();
+      mAnchors.append(
+          std::make_pair(via->getPosition(), QString()));  // on all layers
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        Point pos           = netpoint->getPosition();
-        int   id            = builder.addPoint(pos);
-        pointLayerMap[id]   = std::make_pair(pos, layer->getName());
-        anchorMap[netpoint] = id;
+        anchorMap[netpoint] = mAnchors.count();
+        mAnchors.append(
+            std::make_pair(netpoint->getPosition(), layer->getName()));
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
+      mTraces.append(std::make_pair(anchorMap[&netline->getStartPoint()],
+                                    anchorMap[&netline->getEndPoint()]));
     }
   }
 
-  // determine connections made by planes
-  foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
+  // planes
+  foreach (const BI_Plane* plane, netsignal.getBoardPlanes()) {
     Q_ASSERT(plane);
-    if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
-      int                                           lastId = -1;
-      QHashIterator<int, std::pair<Point, QString>> i(pointLayerMap);
-      while (i.hasNext()) {
-        i.next();
-        const Point&   pos        = i.value().first;
-        const QString& pointLayer = i.value().second;
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          if (fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
+    if (&plane->getBoard() != &board) continue;
+    mPlanes.append(
+        std::make_pair(plane->getLayerName(), plane->getFragments()));
+  }
+}
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() {
+  QVector<int> ids;  // anchor index -> point ID
+  updatePoints(ids);
+
+  // traces
+  QSet<QPair<int, int>> edges;
+  auto addEdge = [&edges](int p1, int p2) {
+    edges.insert(qMakePair(qMin(p1, p2), qMax(p1, p2)));
+  };
+  for (const auto& trace : mTraces) {
+    addEdge(ids.at(trace.first), ids.at(trace.second));
+  }
+
+  // determine connections made by planes
+  for (const auto& plane : mPlanes) {
+    foreach (const Path& fragment, plane.second) {
+      QPainterPath fragmentPx = fragment.toQPainterPathPx();
+      int          lastId     = -1;
+      for (int i = 0; i < mAnchors.count(); ++i) {
+        const Point&   pos        = mAnchors.at(i).first;
+        const QString& pointLayer = mAnchors.at(i).second;
+        if (pointLayer.isNull() || (pointLayer == plane.first)) {
+          if (fragmentPx.contains(pos.toPxQPointF())) {
             if (lastId >= 0) {
-              builder.addEdge(lastId, i.key());
+              addEdge(lastId, ids.at(i));
             }
-            lastId = i.key();
+            lastId = ids.at(i);
           }
         }
       }
     }
   }
 
-  return builder.buildAirWires();
+  updateEdges(edges);
+  return mBuilder->buildAirWires();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardAirWiresBuilder::updatePoints(QVector<int>& ids) noexcept {
+  // The IDs of removed points are never reused, so start over as soon as there
+  // are more removed points than anchors to keep the memory usage bounded.
+  if ((!mBuilder) || (mRemovedPoints > mAnchors.count())) {
+    mBuilder.reset(new AirWiresBuilder());
+    mPointIds.clear();
+    mEdges.clear();
+    mRemovedPoints = 0;
+  }
+
+  // Anchors at the same position as before keep their point ID, all others
+  // are added as new points.
+  QMultiHash<Point, int> pointIds;
+  ids.clear();
+  ids.reserve(mAnchors.count());
+  for (const auto& anchor : mAnchors) {
+    int  id = -1;
+    auto it = mPointIds.find(anchor.first);
+    if (it != mPointIds.end()) {
+      id = it.value();
+      mPointIds.erase(it);
+    } else {
+      id = mBuilder->addPoint(anchor.first);
+    }
+    ids.append(id);
+    pointIds.insert(anchor.first, id);
+  }
+
+  // Points which are left over don't exist anymore (this removes their edges
+  // as well).
+  for (auto it = mPointIds.constBegin(); it != mPointIds.constEnd(); ++it) {
+    mBuilder->removePoint(it.value());
+    ++mRemovedPoints;
+  }
+  mPointIds = pointIds;
+}
+
+void BoardAirWiresBuilder::updateEdges(
+    const QSet<QPair<int, int>>& edges) noexcept {
+  // Note: Edges of removed points were already removed by removePoint().
+  QSet<int> existingIds = Toolbox::toSet(mPointIds.values());
+  foreach (const auto& edge, mEdges) {
+    if ((!edges.contains(edge)) && existingIds.contains(edge.first) &&
+        existingIds.contains(edge.second)) {
+      mBuilder->removeEdge(edge.first, edge.second);
+    }
+  }
+  foreach (const auto& edge, edges) {
+    if (!mEdges.contains(edge)) {
+      mBuilder->addEdge(edge.first, edge.second);
+    }
+  }
+  mEdges = edges;
 }
 
 /*******************************************************************************
@@ -23,14 +23,20 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/point.h>
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
+
+class AirWiresBuilder;
+
 namespace project {
 
 class NetSignal;
@@ -42,24 +48,51 @@ class Board;
 
 /**
  * @brief The BoardAirWiresBuilder class
+ *
+ * The board keeps one builder per net signal alive across airwire rebuilds.
+ * #updateSnapshot() takes a snapshot of all anchors, traces and plane
+ * fragments of the net signal (it must be called in the thread the board lives
+ * in). Afterwards, #buildAirWires() doesn't access the board anymore and can
+ * safely be called from a worker thread, even while the board is being
+ * modified.
+ *
+ * #buildAirWires() only applies the differences to the previous snapshot to
+ * the underlying ::librepcb::AirWiresBuilder: Anchors at unchanged positions
+ * keep their point, so the triangulation is only recalculated if anchors were
+ * added, removed or moved. Modified traces or plane fragments only update the
+ * known connections between the points.
  */
 class BoardAirWiresBuilder final {
 public:
   // Constructors / Destructor
-  BoardAirWiresBuilder()                                  = delete;
+  BoardAirWiresBuilder() noexcept;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
-  BoardAirWiresBuilder(const Board& board, const NetSignal& netsignal) noexcept;
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
-  QVector<QPair<Point, Point>> buildAirWires() const;
+  void updateSnapshot(const Board& board, const NetSignal& netsignal) noexcept;
+  QVector<QPair<Point, Point>> buildAirWires();
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
+private:  // Methods
+  void updatePoints(QVector<int>& ids) noexcept;
+  void updateEdges(const QSet<QPair<int, int>>& edges) noexcept;
+
 private:  // Data
-  const Board&     mBoard;
-  const NetSignal& mNetSignal;
+  /// Position and layer name (null for all layers) of each anchor
+  QVector<std::pair<Point, QString>> mAnchors;
+  /// Indices of the anchors connected by traces
+  QVector<std::pair<int, int>> mTraces;
+  /// Layer name and fragments of each plane
+  QVector<std::pair<QString, QVector<Path>>> mPlanes;
+
+  // State of the previous build
+  std::unique_ptr<AirWiresBuilder> mBuilder;
+  QMultiHash<Point, int>           mPointIds;  ///< Point IDs by position
+  QSet<QPair<int, int>>            mEdges;     ///< Lower point ID first
+  int mRemovedPoints;  ///< Count of removed IDs (they are never reused)
 };
 
 /*******************************************************************************
@@ -56,8 +56,11 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings() noexcept
     mSilkscreenLayersBot(
         {GraphicsLayer::sBotPlacement, GraphicsLayer::sBotNames}),
     mMergeDrillFiles(false),
+    mOptimizeDrillPath(false),
     mEnableSolderPasteTop(false),
-    mEnableSolderPasteBot(false) {
+    mEnableSolderPasteBot(false),
+    mMergeRegions(false),
+    mRegionTolerance(1000) {
 }
 
 BoardFabricationOutputSettings::BoardFabricationOutputSettings(
@@ -88,8 +91,17 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings(
   mSuffixDrillsNpth     = node.getValueByPath<QString>("drills/suffix_npth");
   mSuffixDrills         = node.getValueByPath<QString>("drills/suffix_merged");
   mMergeDrillFiles      = node.getValueByPath<bool>("drills/merge");
+  if (const SExpression* optimize = node.tryGetChildByPath("drills/optimize")) {
+    // optional, added after the file format was released
+    mOptimizeDrillPath = optimize->getValueOfFirstChild<bool>();
+  }
   mEnableSolderPasteTop = node.getValueByPath<bool>("solderpaste_top/create");
   mEnableSolderPasteBot = node.getValueByPath<bool>("solderpaste_bot/create");
+  if (const SExpression* regions = node.tryGetChildByPath("regions")) {
+    // optional, added after the file format was released
+    mMergeRegions    = regions->getValueByPath<bool>("merge");
+    mRegionTolerance = regions->getValueByPath<UnsignedLength>("tolerance");
+  }
 
   mSilkscreenLayersTop.clear();
   foreach (const SExpression& child,
@@ -142,6 +154,10 @@ void BoardFabricationOutputSettings::serialize(SExpression& root) const {
 
   SExpression& drills = root.appendList("drills", true);
   drills.appendChild("merge", mMergeDrillFiles, false);
+  if (mOptimizeDrillPath) {
+    // only written if enabled to not modify existing files
+    drills.appendChild("optimize", mOptimizeDrillPath, false);
+  }
   drills.appendChild("suffix_pth", mSuffixDrillsPth, true);
   drills.appendChild("suffix_npth", mSuffixDrillsNpth, true);
   drills.appendChild("suffix_merged", mSuffixDrills, true);
@@ -153,6 +169,13 @@ void BoardFabricationOutputSettings::serialize(SExpression& root) const {
   SExpression& solderPasteBot = root.appendList("solderpaste_bot", true);
   solderPasteBot.appendChild("create", mEnableSolderPasteBot, false);
   solderPasteBot.appendChild("suffix", mSuffixSolderPasteBot, false);
+
+  // Only write non-default region settings to not modify existing files.
+  if (mMergeRegions || (mRegionTolerance != UnsignedLength(1000))) {
+    SExpression& regions = root.appendList("regions", true);
+    regions.appendChild("merge", mMergeRegions, false);
+    regions.appendChild("tolerance", mRegionTolerance, false);
+  }
 }
 
 /*******************************************************************************
@@ -178,8 +201,11 @@ BoardFabricationOutputSettings& BoardFabricationOutputSettings::operator=(
   mSilkscreenLayersTop  = rhs.mSilkscreenLayersTop;
   mSilkscreenLayersBot  = rhs.mSilkscreenLayersBot;
   mMergeDrillFiles      = rhs.mMergeDrillFiles;
+  mOptimizeDrillPath    = rhs.mOptimizeDrillPath;
   mEnableSolderPasteTop = rhs.mEnableSolderPasteTop;
   mEnableSolderPasteBot = rhs.mEnableSolderPasteBot;
+  mMergeRegions         = rhs.mMergeRegions;
+  mRegionTolerance      = rhs.mRegionTolerance;
   return *this;
 }
 
@@ -202,8 +228,11 @@ bool BoardFabricationOutputSettings::operator==(
   if (mSilkscreenLayersTop != rhs.mSilkscreenLayersTop) return false;
   if (mSilkscreenLayersBot != rhs.mSilkscreenLayersBot) return false;
   if (mMergeDrillFiles != rhs.mMergeDrillFiles) return false;
+  if (mOptimizeDrillPath != rhs.mOptimizeDrillPath) return false;
   if (mEnableSolderPasteTop != rhs.mEnableSolderPasteTop) return false;
   if (mEnableSolderPasteBot != rhs.mEnableSolderPasteBot) return false;
+  if (mMergeRegions != rhs.mMergeRegions) return false;
+  if (mRegionTolerance != rhs.mRegionTolerance) return false;
   return true;
 }
 
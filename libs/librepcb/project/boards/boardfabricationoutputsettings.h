@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/units/length.h>
 
 #include <QtCore>
 
@@ -93,12 +94,17 @@ public:
     return mSilkscreenLayersBot;
   }
   bool getMergeDrillFiles() const noexcept { return mMergeDrillFiles; }
+  bool getOptimizeDrillPath() const noexcept { return mOptimizeDrillPath; }
   bool getEnableSolderPasteTop() const noexcept {
     return mEnableSolderPasteTop;
   }
   bool getEnableSolderPasteBot() const noexcept {
     return mEnableSolderPasteBot;
   }
+  bool getMergeRegions() const noexcept { return mMergeRegions; }
+  const UnsignedLength& getRegionTolerance() const noexcept {
+    return mRegionTolerance;
+  }
 
   // Setters
   void setOutputBasePath(const QString& p) noexcept { mOutputBasePath = p; }
@@ -136,8 +142,13 @@ public:
     mSilkscreenLayersBot = l;
   }
   void setMergeDrillFiles(bool m) noexcept { mMergeDrillFiles = m; }
+  void setOptimizeDrillPath(bool o) noexcept { mOptimizeDrillPath = o; }
   void setEnableSolderPasteTop(bool e) noexcept { mEnableSolderPasteTop = e; }
   void setEnableSolderPasteBot(bool e) noexcept { mEnableSolderPasteBot = e; }
+  void setMergeRegions(bool m) noexcept { mMergeRegions = m; }
+  void setRegionTolerance(const UnsignedLength& t) noexcept {
+    mRegionTolerance = t;
+  }
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -151,25 +162,28 @@ public:
   }
 
 private:  // Data
-  QString     mOutputBasePath;
-  QString     mSuffixDrills;  // NPTH and PTH combined
-  QString     mSuffixDrillsNpth;
-  QString     mSuffixDrillsPth;
-  QString     mSuffixOutlines;
-  QString     mSuffixCopperTop;
-  QString     mSuffixCopperInner;
-  QString     mSuffixCopperBot;
-  QString     mSuffixSolderMaskTop;
-  QString     mSuffixSolderMaskBot;
-  QString     mSuffixSilkscreenTop;
-  QString     mSuffixSilkscreenBot;
-  QString     mSuffixSolderPasteTop;
-  QString     mSuffixSolderPasteBot;
-  QStringList mSilkscreenLayersTop;
-  QStringList mSilkscreenLayersBot;
-  bool        mMergeDrillFiles;
-  bool        mEnableSolderPasteTop;
-  bool        mEnableSolderPasteBot;
+  QString        mOutputBasePath;
+  QString        mSuffixDrills;  // NPTH and PTH combined
+  QString        mSuffixDrillsNpth;
+  QString        mSuffixDrillsPth;
+  QString        mSuffixOutlines;
+  QString        mSuffixCopperTop;
+  QString        mSuffixCopperInner;
+  QString        mSuffixCopperBot;
+  QString        mSuffixSolderMaskTop;
+  QString        mSuffixSolderMaskBot;
+  QString        mSuffixSilkscreenTop;
+  QString        mSuffixSilkscreenBot;
+  QString        mSuffixSolderPasteTop;
+  QString        mSuffixSolderPasteBot;
+  QStringList    mSilkscreenLayersTop;
+  QStringList    mSilkscreenLayersBot;
+  bool           mMergeDrillFiles;
+  bool           mOptimizeDrillPath;
+  bool           mEnableSolderPasteTop;
+  bool           mEnableSolderPasteBot;
+  bool           mMergeRegions;
+  UnsignedLength mRegionTolerance;  // max. deviation of merged regions
 };
 
 /*******************************************************************************
@@ -45,11 +45,15 @@
 #include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/geometry/hole.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -86,25 +90,83 @@ FilePath BoardGerberExport::getOutputDirectory() const noexcept {
 void BoardGerberExport::exportAllLayers() const {
   mWrittenFiles.clear();
 
+  // Each file is generated in a separate job, but the output file paths are
+  // determined in advance by this thread since the attribute substitution
+  // depends on mCurrentInnerCopperLayer.
+  QList<QFuture<FilePath>> jobs;
   if (mSettings->getMergeDrillFiles()) {
-    exportDrills();
+    jobs.append(exportDrills());
   } else {
-    exportDrillsNpth();
-    exportDrillsPth();
-  }
-  exportLayerBoardOutlines();
-  exportLayerTopCopper();
-  exportLayerInnerCopper();
-  exportLayerBottomCopper();
-  exportLayerTopSolderMask();
-  exportLayerBottomSolderMask();
-  exportLayerTopSilkscreen();
-  exportLayerBottomSilkscreen();
+    jobs.append(exportDrillsNpth());
+    jobs.append(exportDrillsPth());
+  }
+  jobs.append(exportLayerBoardOutlines());
+  jobs.append(exportLayerTopCopper());
+  jobs.append(exportLayerInnerCopper());
+  jobs.append(exportLayerBottomCopper());
+  jobs.append(exportLayerTopSolderMask());
+  jobs.append(exportLayerBottomSolderMask());
+  if (mSettings->getSilkscreenLayersTop().count() > 0) {
+    // don't create silkscreen file if no layers selected
+    jobs.append(exportLayerTopSilkscreen());
+  }
+  if (mSettings->getSilkscreenLayersBot().count() > 0) {
+    // don't create silkscreen file if no layers selected
+    jobs.append(exportLayerBottomSilkscreen());
+  }
   if (mSettings->getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste();
+    jobs.append(exportLayerTopSolderPaste());
   }
   if (mSettings->getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste();
+    jobs.append(exportLayerBottomSolderPaste());
+  }
+
+  // Wait for all jobs, even if one of them failed, since they access this
+  // object. The written files are collected in the order of the jobs to get
+  // the same result as with a sequential export.
+  std::unique_ptr<Exception> error;
+  for (int i = 0; i < jobs.count(); ++i) {
+    try {
+      FilePath fp = jobs[i].result();  // can throw
+      if (fp.isValid()) {
+        mWrittenFiles.append(fp);
+      }
+    } catch (const Exception& e) {
+      if (!error) error.reset(e.clone());
+    }
+  }
+  if (error) {
+    error->raise();
+  }
+}
+
+void BoardGerberExport::drawMergedAreas(GerberGenerator&      gen,
+                                        const QVector<Path>&  areas,
+                                        const UnsignedLength& tolerance) {
+  // Unite all areas into as few regions as possible and remove redundant
+  // vertices (e.g. from flattened arcs of plane fragments) to reduce the file
+  // size. Areas containing arcs are drawn unmodified to keep their arcs.
+  ClipperLib::Paths paths;
+  foreach (const Path& area, areas) {
+    bool hasArcs = false;
+    foreach (const Vertex& vertex, area.getVertices()) {
+      if (vertex.getAngle() != 0) hasArcs = true;
+    }
+    if (hasArcs) {
+      gen.drawPathArea(area);
+    } else {
+      // the arc tolerance is irrelevant since there are no arcs
+      paths.push_back(ClipperHelpers::convert(area, PositiveLength(1)));
+    }
+  }
+  if (!paths.empty()) {
+    ClipperHelpers::simplify(paths, tolerance);
+    std::unique_ptr<ClipperLib::PolyTree> tree =
+        ClipperHelpers::uniteToTree(paths);  // can throw
+    paths = ClipperHelpers::flattenTree(*tree);  // can throw
+    foreach (const Path& path, ClipperHelpers::convert(paths)) {
+      gen.drawPathArea(path);
+    }
   }
 }
 
@@ -130,164 +192,144 @@ BoardGerberExport::getAttributeProviderParents() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrills() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrills());
-  ExcellonGenerator gen;
-  drawPthDrills(gen);
-  drawNpthDrills(gen);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportDrills() const {
+  FilePath fp = getOutputFilePath(mSettings->getSuffixDrills());
+  return QtConcurrent::run([this, fp]() {
+    ExcellonGenerator gen;
+    gen.setOptimizeToolPath(mSettings->getOptimizeDrillPath());
+    drawPthDrills(gen);
+    drawNpthDrills(gen);
+    gen.generate();
+    gen.saveToFile(fp);  // can throw
+    return fp;
+  });
 }
 
-void BoardGerberExport::exportDrillsNpth() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrillsNpth());
-  ExcellonGenerator gen;
-  int               count = drawNpthDrills(gen);
-  if (count > 0) {
-    // Some PCB manufacturers don't like to have separate drill files for PTH
-    // and NPTH. As many boards don't have non-plated holes anyway, we create
-    // this file only if it's really needed. Maybe this avoids unnecessary
-    // issues with manufacturers...
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+QFuture<FilePath> BoardGerberExport::exportDrillsNpth() const {
+  FilePath fp = getOutputFilePath(mSettings->getSuffixDrillsNpth());
+  return QtConcurrent::run([this, fp]() -> FilePath {
+    ExcellonGenerator gen;
+    gen.setOptimizeToolPath(mSettings->getOptimizeDrillPath());
+    int count = drawNpthDrills(gen);
+    if (count > 0) {
+      // Some PCB manufacturers don't like to have separate drill files for PTH
+      // and NPTH. As many boards don't have non-plated holes anyway, we create
+      // this file only if it's really needed. Maybe this avoids unnecessary
+      // issues with manufacturers...
+      gen.generate();
+      gen.saveToFile(fp);  // can throw
+      return fp;
+    } else {
+      return FilePath();
+    }
+  });
 }
 
-void BoardGerberExport::exportDrillsPth() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrillsPth());
-  ExcellonGenerator gen;
-  drawPthDrills(gen);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportDrillsPth() const {
+  FilePath fp = getOutputFilePath(mSettings->getSuffixDrillsPth());
+  return QtConcurrent::run([this, fp]() {
+    ExcellonGenerator gen;
+    gen.setOptimizeToolPath(mSettings->getOptimizeDrillPath());
+    drawPthDrills(gen);
+    gen.generate();
+    gen.saveToFile(fp);  // can throw
+    return fp;
+  });
 }
 
-void BoardGerberExport::exportLayerBoardOutlines() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixOutlines());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBoardOutlines);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerBoardOutlines() const {
+  return exportLayer(mSettings->getSuffixOutlines(),
+                     GraphicsLayer::sBoardOutlines);
 }
 
-void BoardGerberExport::exportLayerTopCopper() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerTopCopper() const {
+  return exportLayer(mSettings->getSuffixCopperTop(),
+                     GraphicsLayer::sTopCopper);
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerBottomCopper() const {
+  return exportLayer(mSettings->getSuffixCopperBot(),
+                     GraphicsLayer::sBotCopper);
 }
 
-void BoardGerberExport::exportLayerInnerCopper() const {
+QList<QFuture<FilePath>> BoardGerberExport::exportLayerInnerCopper() const {
+  QList<QFuture<FilePath>> jobs;
   for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
     mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperInner());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    jobs.append(exportLayer(mSettings->getSuffixCopperInner(),
+                            GraphicsLayer::getInnerLayerName(i)));
   }
   mCurrentInnerCopperLayer = 0;
+  return jobs;
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderMaskTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerTopSolderMask() const {
+  return exportLayer(mSettings->getSuffixSolderMaskTop(),
+                     GraphicsLayer::sTopStopMask);
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderMaskBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerBottomSolderMask() const {
+  return exportLayer(mSettings->getSuffixSolderMaskBot(),
+                     GraphicsLayer::sBotStopMask);
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen() const {
+QFuture<FilePath> BoardGerberExport::exportLayerTopSilkscreen() const {
+  FilePath    fp     = getOutputFilePath(mSettings->getSuffixSilkscreenTop());
   QStringList layers = mSettings->getSilkscreenLayersTop();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixSilkscreenTop());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
+  QString     title =
+      mProject.getMetadata().getName() % " - " % mBoard.getName();
+  return QtConcurrent::run([this, fp, layers, title]() {
+    GerberGenerator gen(title, mBoard.getUuid(),
+                        mProject.getMetadata().getVersion());
     foreach (const QString& layer, layers) { drawLayer(gen, layer); }
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sTopStopMask);
     gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+    gen.saveToFile(fp);  // can throw
+    return fp;
+  });
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen() const {
+QFuture<FilePath> BoardGerberExport::exportLayerBottomSilkscreen() const {
+  FilePath    fp     = getOutputFilePath(mSettings->getSuffixSilkscreenBot());
   QStringList layers = mSettings->getSilkscreenLayersBot();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixSilkscreenBot());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
+  QString     title =
+      mProject.getMetadata().getName() % " - " % mBoard.getName();
+  return QtConcurrent::run([this, fp, layers, title]() {
+    GerberGenerator gen(title, mBoard.getUuid(),
+                        mProject.getMetadata().getVersion());
     foreach (const QString& layer, layers) { drawLayer(gen, layer); }
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sBotStopMask);
     gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+    gen.saveToFile(fp);  // can throw
+    return fp;
+  });
+}
+
+QFuture<FilePath> BoardGerberExport::exportLayerTopSolderPaste() const {
+  return exportLayer(mSettings->getSuffixSolderPasteTop(),
+                     GraphicsLayer::sTopSolderPaste);
 }
 
-void BoardGerberExport::exportLayerTopSolderPaste() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderPasteTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayerBottomSolderPaste() const {
+  return exportLayer(mSettings->getSuffixSolderPasteBot(),
+                     GraphicsLayer::sBotSolderPaste);
 }
 
-void BoardGerberExport::exportLayerBottomSolderPaste() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderPasteBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+QFuture<FilePath> BoardGerberExport::exportLayer(
+    const QString& suffix, const QString& layerName) const {
+  FilePath fp = getOutputFilePath(suffix);
+  QString  title =
+      mProject.getMetadata().getName() % " - " % mBoard.getName();
+  return QtConcurrent::run([this, fp, title, layerName]() {
+    GerberGenerator gen(title, mBoard.getUuid(),
+                        mProject.getMetadata().getVersion());
+    drawLayer(gen, layerName);
+    gen.generate();
+    gen.saveToFile(fp);  // can throw
+    return fp;
+  });
 }
 
 int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
@@ -372,12 +414,17 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
     }
   }
 
-  // draw planes
+  // draw planes (if enabled, merged later together with polygon areas)
+  QVector<Path> areas;
   foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
     Q_ASSERT(plane);
     if (plane->getLayerName() == layerName) {
       foreach (const Path& fragment, plane->getFragments()) {
-        gen.drawPathArea(fragment);
+        if (mSettings->getMergeRegions()) {
+          areas.append(fragment);
+        } else {
+          gen.drawPathArea(fragment);
+        }
       }
     }
   }
@@ -393,11 +440,18 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
       // board editor, and because Gerber expects area outlines as closed).
       if (polygon->getPolygon().isFilled() &&
           polygon->getPolygon().getPath().isClosed()) {
-        gen.drawPathArea(polygon->getPolygon().getPath());
+        if (mSettings->getMergeRegions()) {
+          areas.append(polygon->getPolygon().getPath());
+        } else {
+          gen.drawPathArea(polygon->getPolygon().getPath());
+        }
       }
     }
   }
 
+  // draw merged areas of planes and polygons
+  drawMergedAreas(gen, areas, mSettings->getRegionTolerance());  // can throw
+
   // draw stroke texts
   foreach (const BI_StrokeText* text, sortedByUuid(mBoard.getStrokeTexts())) {
     Q_ASSERT(text);
@@ -36,6 +36,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class Path;
 class Polygon;
 class Circle;
 class ExcellonGenerator;
@@ -77,6 +78,18 @@ public:
   // General Methods
   void exportAllLayers() const;
 
+  /**
+   * @brief Draw areas united into as few regions as possible
+   *
+   * @param gen         The Gerber generator to draw into
+   * @param areas       The (closed) areas to draw
+   * @param tolerance   Max. deviation of the drawn regions from the areas
+   *
+   * @throw Exception   If the areas could not be united
+   */
+  static void drawMergedAreas(GerberGenerator& gen, const QVector<Path>& areas,
+                              const UnsignedLength& tolerance);
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -92,19 +105,21 @@ signals:
 
 private:
   // Private Methods
-  void exportDrills() const;
-  void exportDrillsNpth() const;
-  void exportDrillsPth() const;
-  void exportLayerBoardOutlines() const;
-  void exportLayerTopCopper() const;
-  void exportLayerInnerCopper() const;
-  void exportLayerBottomCopper() const;
-  void exportLayerTopSolderMask() const;
-  void exportLayerBottomSolderMask() const;
-  void exportLayerTopSilkscreen() const;
-  void exportLayerBottomSilkscreen() const;
-  void exportLayerTopSolderPaste() const;
-  void exportLayerBottomSolderPaste() const;
+  QFuture<FilePath>        exportDrills() const;
+  QFuture<FilePath>        exportDrillsNpth() const;
+  QFuture<FilePath>        exportDrillsPth() const;
+  QFuture<FilePath>        exportLayerBoardOutlines() const;
+  QFuture<FilePath>        exportLayerTopCopper() const;
+  QList<QFuture<FilePath>> exportLayerInnerCopper() const;
+  QFuture<FilePath>        exportLayerBottomCopper() const;
+  QFuture<FilePath>        exportLayerTopSolderMask() const;
+  QFuture<FilePath>        exportLayerBottomSolderMask() const;
+  QFuture<FilePath>        exportLayerTopSilkscreen() const;
+  QFuture<FilePath>        exportLayerBottomSilkscreen() const;
+  QFuture<FilePath>        exportLayerTopSolderPaste() const;
+  QFuture<FilePath>        exportLayerBottomSolderPaste() const;
+  QFuture<FilePath>        exportLayer(const QString& suffix,
+                                       const QString& layerName) const;
 
   int  drawNpthDrills(ExcellonGenerator& gen) const;
   int  drawPthDrills(ExcellonGenerator& gen) const;
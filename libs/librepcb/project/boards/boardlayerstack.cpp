@@ -126,6 +126,7 @@ void BoardLayerStack::setInnerLayerCount(int count) noexcept {
         layer->setEnabled(layer->getInnerLayerNumber() <= mInnerLayerCount);
       }
     }
+    mBoard.notifyModified();
   }
 }
 
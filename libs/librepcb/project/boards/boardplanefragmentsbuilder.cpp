@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "../circuit/netsignal.h"
+#include "board.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -29,7 +31,6 @@
 #include "items/bi_netline.h"
 #include "items/bi_netpoint.h"
 #include "items/bi_netsegment.h"
-#include "items/bi_plane.h"
 #include "items/bi_polygon.h"
 #include "items/bi_via.h"
 
@@ -38,8 +39,12 @@
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -50,8 +55,71 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    const Board& board, const BoardPlaneFragmentsBuilder* previous) noexcept
+  : mCanceled(false) {
+  // board outlines
+  foreach (const BI_Polygon* polygon, board.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      mBoardOutlines.push_back(ClipperHelpers::convert(
+          polygon->getPolygon().getPath(), maxArcTolerance()));
+    }
+  }
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+        Path path = polygon.getPath();
+        path.rotate(footprint.getRotation());
+        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
+        path.translate(footprint.getPosition());
+        mBoardOutlines.push_back(
+            ClipperHelpers::convert(path, maxArcTolerance()));
+      }
+    }
+  }
+
+  // planes
+  foreach (const BI_Plane* plane, board.getPlanes()) {
+    ClipperLib::Path outline =
+        ClipperHelpers::convert(plane->getOutline(), maxArcTolerance());
+    PlaneData data{plane->getUuid(),
+                   *plane->getLayerName(),
+                   plane->getNetSignal().getUuid(),
+                   outline,
+                   ClipperHelpers::getBounds(outline),
+                   plane->getMinWidth(),
+                   plane->getMinClearance(),
+                   plane->getKeepOrphans(),
+                   plane->getConnectStyle(),
+                   QVector<int>(),
+                   QByteArray(),
+                   QVector<Path>(),
+                   false};
+    // A plane needs the fragments of all planes with higher priority on the
+    // same layer, except planes of the same net signal.
+    for (int i = 0; i < board.getPlanes().count(); ++i) {
+      const BI_Plane* other = board.getPlanes().at(i);
+      if ((other != plane) && (!(*other < *plane)) &&
+          (other->getLayerName() == plane->getLayerName()) &&
+          (&other->getNetSignal() != &plane->getNetSignal())) {
+        data.dependencies.append(i);
+      }
+    }
+    ObstaclesKey key = getObstaclesKey(data);
+    if (!mObstacles.contains(key)) {
+      addObstacles(board, key);
+    }
+    mPlanes.append(data);
+  }
+
+  // results of the previous run
+  if (previous) {
+    foreach (const PlaneData& plane, previous->mPlanes) {
+      mPreviousResults.insert(plane.uuid,
+                              qMakePair(plane.checksum, plane.fragments));
+    }
+  }
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
@@ -61,64 +129,126 @@ BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
  *  General Methods
  ******************************************************************************/
 
-QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
-  try {
-    mResult.clear();
-    addPlaneOutline();
-    clipToBoardOutline();
-    subtractOtherObjects();
-    ensureMinimumWidth();
-    flattenResult();
-    if (!mPlane.getKeepOrphans()) {
-      removeOrphans();
+QHash<Uuid, QVector<Path>>
+    BoardPlaneFragmentsBuilder::buildFragments() noexcept {
+  // determine board area (shared by all planes)
+  mBoardArea.clear();
+  ClipperLib::Clipper boardAreaClipper;
+  boardAreaClipper.AddPaths(mBoardOutlines, ClipperLib::ptSubject, true);
+  boardAreaClipper.Execute(ClipperLib::ctXor, mBoardArea,
+                           ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+  QCryptographicHash boardAreaHash(QCryptographicHash::Md5);
+  for (const ClipperLib::Path& path : mBoardArea) {
+    addToChecksum(boardAreaHash, path);
+  }
+  mBoardAreaChecksum = boardAreaHash.result();
+
+  // Group planes into stages: All planes within a stage are independent of
+  // each other, so they can be filled concurrently.
+  QVector<int> stages(mPlanes.count(), -1);
+  std::function<int(int)> determineStage = [&](int index) {
+    if (stages.at(index) < 0) {
+      int stage = 0;
+      foreach (int dependency, mPlanes.at(index).dependencies) {
+        stage = std::max(stage, determineStage(dependency) + 1);
+      }
+      stages[index] = stage;
     }
-    return ClipperHelpers::convert(mResult);
-  } catch (const Exception& e) {
-    qCritical() << "Failed to build plane fragments! Leave plane empty...";
-    qCritical() << "Inner error message:" << e.getMsg();
-    return QVector<Path>();
+    return stages.at(index);
+  };
+  int stageCount = 0;
+  for (int i = 0; i < mPlanes.count(); ++i) {
+    stageCount = std::max(stageCount, determineStage(i) + 1);
   }
+
+  // Fill planes stage by stage. Each job only modifies its own plane data,
+  // so they don't interfere with each other.
+  PlaneData* planes = mPlanes.data();  // detach before starting the jobs
+  for (int stage = 0; stage < stageCount; ++stage) {
+    QList<QFuture<void>> futures;
+    for (int i = 0; i < mPlanes.count(); ++i) {
+      if (stages.at(i) == stage) {
+        PlaneData* plane = &planes[i];
+        futures.append(
+            QtConcurrent::run([this, plane]() { fillPlane(*plane); }));
+      }
+    }
+    for (QFuture<void>& future : futures) {
+      future.waitForFinished();
+    }
+  }
+
+  QHash<Uuid, QVector<Path>> result;
+  foreach (const PlaneData& plane, mPlanes) {
+    result.insert(plane.uuid, plane.fragments);
+  }
+  return result;
+}
+
+QSet<Uuid> BoardPlaneFragmentsBuilder::getRebuiltPlanes() const noexcept {
+  QSet<Uuid> uuids;
+  foreach (const PlaneData& plane, mPlanes) {
+    if (plane.rebuilt) {
+      uuids.insert(plane.uuid);
+    }
+  }
+  return uuids;
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
-}
+void BoardPlaneFragmentsBuilder::fillPlane(PlaneData& plane) const noexcept {
+  if (mCanceled) {
+    return;
+  }
 
-void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
-  // determine board area
-  ClipperLib::Paths   boardArea;
-  ClipperLib::Clipper boardAreaClipper;
-  foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
-    }
+  QVector<const Obstacle*> obstacles = getRelevantObstacles(plane);
+  plane.checksum                     = calculateChecksum(plane, obstacles);
+  auto previous                      = mPreviousResults.constFind(plane.uuid);
+  if ((previous != mPreviousResults.constEnd()) &&
+      (previous->first == plane.checksum)) {
+    plane.fragments = previous->second;  // nothing changed, reuse fragments
+    plane.rebuilt   = false;
+  } else {
+    plane.fragments = buildPlaneFragments(plane, obstacles);
+    plane.rebuilt   = true;
   }
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
-      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
-        Path path = polygon.getPath();
-        path.rotate(footprint.getRotation());
-        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(footprint.getPosition());
-        ClipperLib::Path clipperPath =
-            ClipperHelpers::convert(path, maxArcTolerance());
-        boardAreaClipper.AddPath(clipperPath, ClipperLib::ptSubject, true);
-      }
+}
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildPlaneFragments(
+    const PlaneData&                plane,
+    const QVector<const Obstacle*>& obstacles) const noexcept {
+  try {
+    ClipperLib::Paths result;
+    ClipperLib::Paths connectedAreas;
+    addPlaneOutline(plane, result);
+    clipToBoardOutline(plane, result);
+    subtractOtherObjects(plane, obstacles, result, connectedAreas);
+    ensureMinimumWidth(plane, result);
+    flattenResult(result);
+    if (!plane.keepOrphans) {
+      removeOrphans(connectedAreas, result);
     }
+    return ClipperHelpers::convert(result);
+  } catch (const Exception& e) {
+    qCritical() << "Failed to build plane fragments! Leave plane empty...";
+    qCritical() << "Inner error message:" << e.getMsg();
+    return QVector<Path>();
   }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
+}
 
+void BoardPlaneFragmentsBuilder::addPlaneOutline(
+    const PlaneData& plane, ClipperLib::Paths& result) const {
+  result.push_back(plane.outline);
+}
+
+void BoardPlaneFragmentsBuilder::clipToBoardOutline(
+    const PlaneData& plane, ClipperLib::Paths& result) const {
   // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
+  ClipperLib::Paths boardArea = mBoardArea;
+  ClipperHelpers::offset(boardArea, -plane.minClearance,
                          maxArcTolerance());  // can throw
 
   // if we have no board area, abort here
@@ -126,154 +256,219 @@ void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
 
   // clip result to board area
   ClipperLib::Clipper clip;
-  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
+  clip.AddPaths(result, ClipperLib::ptSubject, true);
   clip.AddPaths(boardArea, ClipperLib::ptClip, true);
-  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
+  clip.Execute(ClipperLib::ctIntersection, result, ClipperLib::pftNonZero,
                ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
+void BoardPlaneFragmentsBuilder::subtractOtherObjects(
+    const PlaneData& plane, const QVector<const Obstacle*>& obstacles,
+    ClipperLib::Paths& result, ClipperLib::Paths& connectedAreas) const {
   ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+  c.AddPaths(result, ClipperLib::ptSubject, true);
 
   // subtract other planes
-  foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-    if (plane == &mPlane) continue;
-    if (*plane < mPlane) continue;  // ignore planes with lower priority
-    if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-    ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
+  foreach (int dependency, plane.dependencies) {
+    if (!isRelevantDependency(plane, dependency)) continue;
+    ClipperLib::Paths paths = ClipperHelpers::convert(
+        mPlanes.at(dependency).fragments, maxArcTolerance());
+    ClipperHelpers::offset(paths, *plane.minClearance,
                            maxArcTolerance());  // can throw
     c.AddPaths(paths, ClipperLib::ptClip, true);
   }
 
-  // subtract holes and pads from devices
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    for (const Hole& hole :
-         device->getFootprint().getLibFootprint().getHoles()) {
-      Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
-    }
-    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
-    }
-  }
-
-  // subtract board holes
-  for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
-  }
-
-  // subtract net segment items
-  foreach (const BI_NetSegment* netsegment,
-           mPlane.getBoard().getNetSegments()) {
-    // subtract vias
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
+  // subtract holes, pads, vias and netlines
+  foreach (const Obstacle* obstacle, obstacles) {
+    bool sameNetSignal = (obstacle->netSignal == plane.netSignal);
+    if (sameNetSignal) {
+      connectedAreas.push_back(obstacle->area);
     }
-
-    // subtract netlines
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
-      }
+    if ((!sameNetSignal) ||
+        ((obstacle->type != Obstacle::Type::NetLine) &&
+         (plane.connectStyle == BI_Plane::ConnectStyle::None))) {
+      c.AddPath(obstacle->cutOut, ClipperLib::ptClip, true);
     }
   }
 
-  c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
+  c.Execute(ClipperLib::ctDifference, result, ClipperLib::pftEvenOdd,
             ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
-  ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
-  ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
+void BoardPlaneFragmentsBuilder::ensureMinimumWidth(
+    const PlaneData& plane, ClipperLib::Paths& result) const {
+  Length delta = plane.minWidth / 2;
+  ClipperHelpers::offset(result, -delta, maxArcTolerance());  // can throw
+  ClipperHelpers::offset(result, delta, maxArcTolerance());   // can throw
 }
 
-void BoardPlaneFragmentsBuilder::flattenResult() {
+void BoardPlaneFragmentsBuilder::flattenResult(
+    ClipperLib::Paths& result) const {
   // convert paths to tree
   ClipperLib::PolyTree tree;
   ClipperLib::Clipper  c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+  c.AddPaths(result, ClipperLib::ptSubject, true);
   c.Execute(ClipperLib::ctXor, tree, ClipperLib::pftEvenOdd,
             ClipperLib::pftEvenOdd);
 
   // convert tree to simple paths with cut-ins
-  mResult = ClipperHelpers::flattenTree(tree);  // can throw
+  result = ClipperHelpers::flattenTree(tree);  // can throw
 }
 
-void BoardPlaneFragmentsBuilder::removeOrphans() {
-  mResult.erase(std::remove_if(
-                    mResult.begin(), mResult.end(),
-                    [this](const ClipperLib::Path& p) {
-                      ClipperLib::Paths   intersections;
-                      ClipperLib::Clipper c;
-                      c.AddPaths(mConnectedNetSignalAreas,
-                                 ClipperLib::ptSubject, true);
-                      c.AddPath(p, ClipperLib::ptClip, true);
-                      c.Execute(ClipperLib::ctIntersection, intersections,
-                                ClipperLib::pftNonZero, ClipperLib::pftNonZero);
-                      return intersections.empty();
-                    }),
-                mResult.end());
+void BoardPlaneFragmentsBuilder::removeOrphans(
+    const ClipperLib::Paths& connectedAreas, ClipperLib::Paths& result) const {
+  result.erase(std::remove_if(
+                   result.begin(), result.end(),
+                   [&connectedAreas](const ClipperLib::Path& p) {
+                     ClipperLib::Paths   intersections;
+                     ClipperLib::Clipper c;
+                     c.AddPaths(connectedAreas, ClipperLib::ptSubject, true);
+                     c.AddPath(p, ClipperLib::ptClip, true);
+                     c.Execute(ClipperLib::ctIntersection, intersections,
+                               ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+                     return intersections.empty();
+                   }),
+               result.end());
 }
 
 /*******************************************************************************
  *  Helper Methods
  ******************************************************************************/
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
-    const BI_FootprintPad& pad) const noexcept {
-  bool differentNetSignal =
-      (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
+void BoardPlaneFragmentsBuilder::addObstacles(
+    const Board& board, const ObstaclesKey& key) noexcept {
+  const QString&     layerName = key.first;
+  Length             clearance(key.second);
+  QVector<Obstacle>& obstacles = mObstacles[key];
+
+  // holes and pads from devices
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    for (const Hole& hole :
+         device->getFootprint().getLibFootprint().getHoles()) {
+      Point pos = device->getFootprint().mapToScene(hole.getPosition());
+      PositiveLength dia(hole.getDiameter() + clearance * 2);
+      Path           path = Path::circle(dia).translated(pos);
+      addObstacle(obstacles, Obstacle::Type::Hole, tl::nullopt, Path(), path);
+    }
+    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if (!pad->isOnLayer(layerName)) continue;
+      const NetSignal*   netsignal = pad->getCompSigInstNetSignal();
+      tl::optional<Uuid> netsignalUuid;
+      if (netsignal) netsignalUuid = netsignal->getUuid();
+      addObstacle(obstacles, Obstacle::Type::Pad, netsignalUuid,
+                  pad->getSceneOutline(), pad->getSceneOutline(clearance));
+    }
+  }
+
+  // board holes
+  for (const BI_Hole* hole : board.getHoles()) {
+    PositiveLength dia(hole->getHole().getDiameter() + clearance * 2);
+    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
+    addObstacle(obstacles, Obstacle::Type::Hole, tl::nullopt, Path(), path);
+  }
+
+  // net segment items
+  foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+    Uuid netsignal = netsegment->getNetSignal().getUuid();
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      addObstacle(obstacles, Obstacle::Type::Via, netsignal,
+                  via->getSceneOutline(), via->getSceneOutline(clearance));
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().getName() != layerName) continue;
+      addObstacle(obstacles, Obstacle::Type::NetLine, netsignal,
+                  netline->getSceneOutline(),
+                  netline->getSceneOutline(clearance));
+    }
   }
 }
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
-  bool differentNetSignal =
-      (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
+void BoardPlaneFragmentsBuilder::addObstacle(
+    QVector<Obstacle>& obstacles, Obstacle::Type type,
+    const tl::optional<Uuid>& netSignal, const Path& area,
+    const Path& cutOut) const noexcept {
+  Obstacle obstacle{type,
+                    netSignal,
+                    ClipperHelpers::convert(area, maxArcTolerance()),
+                    ClipperHelpers::convert(cutOut, maxArcTolerance()),
+                    ClipperLib::IntRect(),
+                    QByteArray()};
+  obstacle.bounds = ClipperHelpers::getBounds(obstacle.cutOut);
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  hash.addData(QByteArray::number(static_cast<int>(type)));
+  addToChecksum(hash, obstacle.area);
+  addToChecksum(hash, obstacle.cutOut);
+  obstacle.checksum = hash.result();
+  obstacles.append(obstacle);
+}
+
+QVector<const BoardPlaneFragmentsBuilder::Obstacle*>
+    BoardPlaneFragmentsBuilder::getRelevantObstacles(
+        const PlaneData& plane) const noexcept {
+  // Obstacles outside the plane outline neither affect the plane area nor
+  // the connected areas (which are only used to detect orphans), so they
+  // can be skipped.
+  QVector<const Obstacle*> relevant;
+  auto                     it = mObstacles.constFind(getObstaclesKey(plane));
+  if (it != mObstacles.constEnd()) {
+    for (const Obstacle& obstacle : *it) {
+      if (ClipperHelpers::boundsOverlap(obstacle.bounds, plane.bounds)) {
+        relevant.append(&obstacle);
+      }
+    }
+  }
+  return relevant;
+}
+
+bool BoardPlaneFragmentsBuilder::isRelevantDependency(const PlaneData& plane,
+                                                      int dependency) const
+    noexcept {
+  // the fragments of the other plane are always within its outline
+  ClipperLib::IntRect bounds    = mPlanes.at(dependency).bounds;
+  ClipperLib::cInt    clearance = plane.minClearance->toNm();
+  bounds.left -= clearance;
+  bounds.top -= clearance;
+  bounds.right += clearance;
+  bounds.bottom += clearance;
+  return ClipperHelpers::boundsOverlap(bounds, plane.bounds);
+}
+
+QByteArray BoardPlaneFragmentsBuilder::calculateChecksum(
+    const PlaneData&                plane,
+    const QVector<const Obstacle*>& obstacles) const noexcept {
+  QByteArray  data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream << mBoardAreaChecksum << plane.minWidth->toNm()
+         << plane.minClearance->toNm() << plane.keepOrphans
+         << static_cast<int>(plane.connectStyle);
+  foreach (int dependency, plane.dependencies) {
+    if (isRelevantDependency(plane, dependency)) {
+      // the fragments are fully determined by the checksum of their inputs
+      stream << mPlanes.at(dependency).checksum;
+    }
+  }
+  foreach (const Obstacle* obstacle, obstacles) {
+    stream << obstacle->checksum << (obstacle->netSignal == plane.netSignal);
   }
+
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  hash.addData(data);
+  addToChecksum(hash, plane.outline);
+  return hash.result();
+}
+
+void BoardPlaneFragmentsBuilder::addToChecksum(
+    QCryptographicHash& hash, const ClipperLib::Path& path) noexcept {
+  qint64 size = static_cast<qint64>(path.size());
+  hash.addData(reinterpret_cast<const char*>(&size), sizeof(size));
+  hash.addData(reinterpret_cast<const char*>(path.data()),
+               static_cast<int>(path.size() * sizeof(ClipperLib::IntPoint)));
+}
+
+BoardPlaneFragmentsBuilder::ObstaclesKey
+    BoardPlaneFragmentsBuilder::getObstaclesKey(
+        const PlaneData& plane) noexcept {
+  return qMakePair(plane.layerName, plane.minClearance->toNm());
 }
 
 /*******************************************************************************
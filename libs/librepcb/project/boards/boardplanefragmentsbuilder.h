@@ -23,20 +23,25 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "items/bi_plane.h"
+
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/uuid.h>
+
+#include <optional/tl/optional.hpp>
 
 #include <QtCore>
 
+#include <atomic>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
-class BI_Plane;
-class BI_Via;
-class BI_FootprintPad;
+class Board;
 
 /*******************************************************************************
  *  Class BoardPlaneFragmentsBuilder
@@ -44,33 +49,127 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The constructor takes a snapshot of all data needed to fill the planes of a
+ * board (it must be called in the thread the board lives in). Afterwards,
+ * #buildFragments() doesn't access the board anymore. It fills independent
+ * planes concurrently on the global thread pool, while planes which need the
+ * fragments of higher priority planes on the same layer are filled after them.
+ * The board outline and the obstacles of each layer are determined only once
+ * and are shared between all planes.
+ *
+ * Only obstacles whose bounding box overlaps with the plane outline are taken
+ * into account for a plane. In addition, a checksum over all input data of
+ * each plane is calculated. If the builder of the previous run is passed to
+ * the constructor, planes whose checksum has not changed since that run are
+ * not filled again but their previous fragments are reused.
+ *
+ * A running #buildFragments() can be aborted from any thread with #cancel().
  */
 class BoardPlaneFragmentsBuilder final {
 public:
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder()                                        = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  BoardPlaneFragmentsBuilder(
+      const Board&                      board,
+      const BoardPlaneFragmentsBuilder* previous = nullptr) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
   // General Methods
-  QVector<Path> buildFragments() noexcept;
+
+  /**
+   * @brief Fill all planes of the board
+   *
+   * @return The fragments of every plane, accessed by plane UUID
+   */
+  QHash<Uuid, QVector<Path>> buildFragments() noexcept;
+
+  /**
+   * @brief Get the planes which were actually filled by #buildFragments()
+   *
+   * @return UUIDs of all planes whose fragments were not reused from the
+   *         previous run
+   */
+  QSet<Uuid> getRebuiltPlanes() const noexcept;
+
+  /**
+   * @brief Abort a running (or the next) #buildFragments() call
+   *
+   * Planes which are not filled yet are skipped, so the result of
+   * #buildFragments() is incomplete and must be discarded. This method is
+   * thread-safe.
+   */
+  void cancel() noexcept { mCanceled = true; }
+  bool isCanceled() const noexcept { return mCanceled; }
 
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
 
+private:  // Types
+  struct Obstacle {
+    enum class Type { Hole, Pad, Via, NetLine };
+    Type                type;
+    tl::optional<Uuid>  netSignal;  ///< nullopt if not connected to a net
+    ClipperLib::Path    area;       ///< copper area (without clearance)
+    ClipperLib::Path    cutOut;     ///< area including the plane clearance
+    ClipperLib::IntRect bounds;     ///< bounding box of #cutOut
+    QByteArray          checksum;
+  };
+
+  struct PlaneData {
+    Uuid                   uuid;
+    QString                layerName;
+    Uuid                   netSignal;
+    ClipperLib::Path       outline;
+    ClipperLib::IntRect    bounds;  ///< bounding box of #outline
+    UnsignedLength         minWidth;
+    UnsignedLength         minClearance;
+    bool                   keepOrphans;
+    BI_Plane::ConnectStyle connectStyle;
+    QVector<int>           dependencies;  ///< planes to be filled before
+    QByteArray             checksum;      ///< over all input data
+    QVector<Path>          fragments;
+    bool                   rebuilt;  ///< false if fragments were reused
+  };
+
+  /// Layer name and clearance
+  typedef QPair<QString, qint64> ObstaclesKey;
+
 private:  // Methods
-  void addPlaneOutline();
-  void clipToBoardOutline();
-  void subtractOtherObjects();
-  void ensureMinimumWidth();
-  void flattenResult();
-  void removeOrphans();
+  void          fillPlane(PlaneData& plane) const noexcept;
+  QVector<Path> buildPlaneFragments(
+      const PlaneData&                plane,
+      const QVector<const Obstacle*>& obstacles) const noexcept;
+  void addPlaneOutline(const PlaneData& plane, ClipperLib::Paths& result) const;
+  void clipToBoardOutline(const PlaneData&   plane,
+                          ClipperLib::Paths& result) const;
+  void subtractOtherObjects(const PlaneData&                plane,
+                            const QVector<const Obstacle*>& obstacles,
+                            ClipperLib::Paths&              result,
+                            ClipperLib::Paths& connectedAreas) const;
+  void ensureMinimumWidth(const PlaneData&   plane,
+                          ClipperLib::Paths& result) const;
+  void flattenResult(ClipperLib::Paths& result) const;
+  void removeOrphans(const ClipperLib::Paths& connectedAreas,
+                     ClipperLib::Paths&       result) const;
 
   // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+  void addObstacles(const Board& board, const ObstaclesKey& key) noexcept;
+  void addObstacle(QVector<Obstacle>& obstacles, Obstacle::Type type,
+                   const tl::optional<Uuid>& netSignal, const Path& area,
+                   const Path& cutOut) const noexcept;
+  QVector<const Obstacle*> getRelevantObstacles(const PlaneData& plane) const
+      noexcept;
+  bool isRelevantDependency(const PlaneData& plane, int dependency) const
+      noexcept;
+  QByteArray calculateChecksum(const PlaneData&                plane,
+                               const QVector<const Obstacle*>& obstacles) const
+      noexcept;
+  static void addToChecksum(QCryptographicHash&     hash,
+                            const ClipperLib::Path& path) noexcept;
+  static ObstaclesKey getObstaclesKey(const PlaneData& plane) noexcept;
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs. Do not
@@ -82,9 +181,16 @@ private:  // Methods
   }
 
 private:  // Data
-  BI_Plane&         mPlane;
-  ClipperLib::Paths mConnectedNetSignalAreas;
-  ClipperLib::Paths mResult;
+  ClipperLib::Paths                      mBoardOutlines;
+  ClipperLib::Paths                      mBoardArea;
+  QByteArray                             mBoardAreaChecksum;
+  QVector<PlaneData>                     mPlanes;
+  QHash<ObstaclesKey, QVector<Obstacle>> mObstacles;
+
+  /// Checksums and fragments of the previous run, accessed by plane UUID
+  QHash<Uuid, QPair<QByteArray, QVector<Path>>> mPreviousResults;
+
+  std::atomic<bool> mCanceled;
 };
 
 /*******************************************************************************
@@ -61,11 +61,13 @@ bool CmdBoardDesignRulesModify::performExecute() {
 
 void CmdBoardDesignRulesModify::performUndo() {
   mBoard.getDesignRules() = mOldRules;
+  mBoard.notifyModified();
   emit mBoard.attributesChanged();
 }
 
 void CmdBoardDesignRulesModify::performRedo() {
   mBoard.getDesignRules() = mNewRules;
+  mBoard.notifyModified();
   emit mBoard.attributesChanged();
 }
 
@@ -168,7 +168,7 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setKeepOrphans(mOldKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().schedulePlanesRebuild();
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -182,7 +182,7 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setKeepOrphans(mNewKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().schedulePlanesRebuild();
 }
 
 /*******************************************************************************
@@ -36,19 +36,24 @@
 #include "../items/bi_netline.h"
 #include "../items/bi_netsegment.h"
 #include "../items/bi_plane.h"
+#include "../items/bi_polygon.h"
 #include "../items/bi_stroketext.h"
 #include "../items/bi_via.h"
 #include "boardclipperpathgenerator.h"
 
 #include <librepcb/common/geometry/hole.h>
 #include <librepcb/common/geometry/stroketext.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/toolbox.h>
 #include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -61,7 +66,15 @@ namespace project {
 
 BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board, const Options& options,
                                            QObject* parent) noexcept
-  : QObject(parent), mBoard(board), mOptions(options), mMessages() {
+  : QObject(parent),
+    mBoard(board),
+    mOptions(options),
+    mMessages(),
+    mIncrementalStateValid(false) {
+  connect(&mBoard, &Board::itemModified, this,
+          &BoardDesignRuleCheck::boardItemModified);
+  connect(&mClearanceChecksWatcher, &QFutureWatcherBase::finished, this,
+          &BoardDesignRuleCheck::clearanceChecksFinished);
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
@@ -72,20 +85,28 @@ BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
  ******************************************************************************/
 
 void BoardDesignRuleCheck::execute() {
+  if (isRunning()) {
+    throw LogicError(__FILE__, __LINE__);
+  }
+
   emit started();
   emit progressPercent(5);
 
   mMessages.clear();
+  mAreaMessages.clear();
+  mCachedPaths.clear();
+  mCheckArea             = tl::nullopt;
+  mIncrementalStateValid = false;
 
+  // These steps modify the board, so they have to be done before any worker
+  // thread starts reading from the board.
   rebuildPlanes(5, 15);
-  checkCopperBoardClearances(15, 40);
-  checkCopperCopperClearances(40, 70);
-  checkMinimumCopperWidth(70, 72);
-  checkMinimumPthRestring(72, 74);
-  checkMinimumPthDrillDiameter(74, 76);
-  checkMinimumNpthDrillDiameter(76, 78);
-  checkCourtyardClearances(78, 88);
-  checkForMissingConnections(88, 90);
+  mBoard.forceAirWiresRebuild();
+
+  mItemStates = getItemStates();
+  mModifiedItems.clear();
+  finishChecks(runChecks());  // can throw
+  mIncrementalStateValid = true;
 
   emit progressStatus(QString(tr("Finished with %1 message(s)!",
                                  "Count of messages", mMessages.count()))
@@ -94,6 +115,36 @@ void BoardDesignRuleCheck::execute() {
   emit finished();
 }
 
+void BoardDesignRuleCheck::startIncremental() {
+  if (isRunning()) {
+    throw LogicError(__FILE__, __LINE__);
+  }
+
+  emit started();
+  emit progressPercent(5);
+
+  mMessages.clear();
+
+  // Planes and airwires are not rebuilt here since this is intended to be
+  // called after every modification of the board, so only the items modified
+  // since the previous run determine the area to be checked.
+  updateCheckArea();
+  mIncrementalStateValid = false;  // until the checks succeeded
+
+  // Keep the messages of the previous run which are outside of this area.
+  QList<BoardDesignRuleCheckMessage> areaMessages;
+  foreach (const BoardDesignRuleCheckMessage& msg, mAreaMessages) {
+    if (!isInCheckArea(msg)) {
+      areaMessages.append(msg);
+    }
+  }
+  mAreaMessages = areaMessages;
+  emit progressPercent(15);
+
+  // finished in clearanceChecksFinished()
+  mClearanceChecksWatcher.setFuture(runChecks());  // can throw
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -105,180 +156,450 @@ void BoardDesignRuleCheck::rebuildPlanes(int progressStart, int progressEnd) {
   emit progressPercent(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkForMissingConnections(int progressStart,
-                                                      int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check for missing connections..."));
+QFuture<QList<BoardDesignRuleCheckMessage>> BoardDesignRuleCheck::runChecks() {
+  mPendingAreaMessages.clear();
+  mPendingMessages.clear();
+  QList<BoardDesignRuleCheckMessage> missingConnections =
+      checkForMissingConnections();
+  prepareCopperPaths();  // can throw
+
+  // The clearance checks only need the prepared copper paths, so they don't
+  // access the board at all and may still be running after returning from
+  // this method. The results of the mapped checks keep their order.
+  std::shared_ptr<const ClearanceCheckInput> input = getClearanceCheckInput();
+  QList<ClearanceCheck>                      clearanceChecks;
+  for (int i = 0; i < input->layers.count(); ++i) {
+    clearanceChecks.append(ClearanceCheck{input, i, false});
+  }
+  for (int i = 0; i < input->layers.count(); ++i) {
+    clearanceChecks.append(ClearanceCheck{input, i, true});
+  }
+  QFuture<QList<BoardDesignRuleCheckMessage>> clearances =
+      QtConcurrent::mapped(clearanceChecks,
+                           &BoardDesignRuleCheck::checkClearances);
+
+  // All the remaining checks only read from the board, so they are executed
+  // concurrently on the global thread pool, but they need to be finished
+  // before returning to the event loop. The results are collected in the same
+  // order as the checks are listed here to get deterministic messages and
+  // progress signals.
+  struct Check {
+    QString                                            status;
+    int                                                progressEnd;
+    bool                                               limitedToArea;
+    QList<QFuture<QList<BoardDesignRuleCheckMessage>>> results;
+  };
+  QList<Check> checks;
+  auto         waitForChecks = scopeGuard([&checks]() {
+    // Make sure no worker accesses this object anymore if we leave early.
+    foreach (const Check& check, checks) {
+      foreach (QFuture<QList<BoardDesignRuleCheckMessage>> result,
+               check.results) {
+        try {
+          result.waitForFinished();
+        } catch (...) {
+        }
+      }
+    }
+  });
+  checks.append(Check{tr("Check minimum copper width..."), 20, true, {}});
+  checks.last().results.append(
+      QtConcurrent::run([this]() { return checkMinimumCopperWidth(); }));
+  checks.append(Check{tr("Check minimum PTH restrings..."), 25, true, {}});
+  checks.last().results.append(
+      QtConcurrent::run([this]() { return checkMinimumPthRestring(); }));
+  checks.append(
+      Check{tr("Check minimum PTH drill diameters..."), 30, true, {}});
+  checks.last().results.append(
+      QtConcurrent::run([this]() { return checkMinimumPthDrillDiameter(); }));
+  checks.append(
+      Check{tr("Check minimum NPTH drill diameters..."), 35, true, {}});
+  checks.last().results.append(
+      QtConcurrent::run([this]() { return checkMinimumNpthDrillDiameter(); }));
+  checks.append(Check{tr("Check courtyard clearances..."), 40, false, {}});
+  auto courtyardLayers = mBoard.getLayerStack().getLayers(
+      {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
+  foreach (const GraphicsLayer* layer, courtyardLayers) {
+    checks.last().results.append(QtConcurrent::run(
+        [this, layer]() { return checkCourtyardClearances(*layer); }));
+  }
+
+  int progress = 15;
+  foreach (const Check& check, checks) {
+    emit progressStatus(check.status);
+    for (int i = 0; i < check.results.count(); ++i) {
+      QFuture<QList<BoardDesignRuleCheckMessage>> result = check.results[i];
+      foreach (const BoardDesignRuleCheckMessage& msg,
+               result.result()) {  // can throw
+        if (!check.limitedToArea) {
+          mPendingMessages.append(msg);
+        } else if (isInCheckArea(msg)) {
+          mPendingAreaMessages.append(msg);
+        }  // else: message of the previous run is still valid
+      }
+      emit progressPercent(progress + (check.progressEnd - progress) * (i + 1) /
+                                          check.results.count());
+    }
+    progress = check.progressEnd;
+    emit progressPercent(progress);
+  }
+
+  emit progressStatus(tr("Check copper clearances..."));
+  mPendingMessages.append(missingConnections);
+  return clearances;
+}
+
+void BoardDesignRuleCheck::finishChecks(
+    const QFuture<QList<BoardDesignRuleCheckMessage>>& result) {
+  QList<BoardDesignRuleCheckMessage> areaMessages;
+  foreach (const QList<BoardDesignRuleCheckMessage>& messages,
+           result.results()) {  // can throw
+    foreach (const BoardDesignRuleCheckMessage& msg, messages) {
+      if (isInCheckArea(msg)) {
+        areaMessages.append(msg);
+      }  // else: message of the previous run is still valid
+    }
+  }
+  emit progressPercent(85);
+
+  // Messages taken over from the previous run
+  foreach (const BoardDesignRuleCheckMessage& msg, mAreaMessages) {
+    addMessage(msg);
+  }
+
+  areaMessages.append(mPendingAreaMessages);
+  foreach (const BoardDesignRuleCheckMessage& msg, areaMessages) {
+    mAreaMessages.append(msg);
+    addMessage(msg);
+  }
+  foreach (const BoardDesignRuleCheckMessage& msg, mPendingMessages) {
+    addMessage(msg);
+  }
+  mPendingAreaMessages.clear();
+  mPendingMessages.clear();
+  emit progressPercent(90);
+}
+
+void BoardDesignRuleCheck::clearanceChecksFinished() noexcept {
+  try {
+    finishChecks(mClearanceChecksWatcher.future());  // can throw
+    mIncrementalStateValid = true;
+  } catch (const Exception& e) {
+    emit failed(e.getMsg());
+    return;
+  }
+
+  emit progressStatus(QString(tr("Finished with %1 message(s)!",
+                                 "Count of messages", mMessages.count()))
+                          .arg(mMessages.count()));
+  emit progressPercent(100);
+  emit finished();
+}
+
+std::shared_ptr<const BoardDesignRuleCheck::ClearanceCheckInput>
+    BoardDesignRuleCheck::getClearanceCheckInput() const {
+  std::shared_ptr<ClearanceCheckInput> input =
+      std::make_shared<ClearanceCheckInput>();
+  input->options               = mOptions;
+  input->outlineRestrictedArea = mOutlineRestrictedArea;
+  foreach (const NetSignal* netsignal,
+           mBoard.getProject().getCircuit().getNetSignals()) {
+    input->netsignals.append(netsignal);
+    input->netNames.append(*netsignal->getName());
+  }
+  input->netsignals.append(nullptr);  // also check unconnected copper objects
+  input->netNames.append(QString());
+  foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+    if (layer->isCopperLayer() && layer->isEnabled()) {
+      // cheap since the cached paths are implicitly shared
+      input->layers.append(
+          CopperLayer{layer->getNameTr(), mCachedPaths.value(layer)});
+    }
+  }
+
+  // The copper is clipped to the area to check. The area is extended by the
+  // clearance to get the whole violations at its border.
+  input->checkArea = mCheckArea;
+  if (mCheckArea) {
+    Length margin = qMax(*mOptions.minCopperCopperClearance,
+                         *mOptions.minCopperBoardClearance);
+    foreach (const ClipperLib::IntRect& rect, *mCheckArea) {
+      ClipperLib::cInt left   = rect.left - margin.toNm();
+      ClipperLib::cInt top    = rect.top - margin.toNm();
+      ClipperLib::cInt right  = rect.right + margin.toNm();
+      ClipperLib::cInt bottom = rect.bottom + margin.toNm();
+      ClipperLib::Path path   = {ClipperLib::IntPoint(left, top),
+                               ClipperLib::IntPoint(right, top),
+                               ClipperLib::IntPoint(right, bottom),
+                               ClipperLib::IntPoint(left, bottom)};
+      ClipperHelpers::unite(input->checkAreaPaths, path);  // can throw
+    }
+  }
+  return input;
+}
+
+QList<BoardDesignRuleCheckMessage> BoardDesignRuleCheck::checkClearances(
+    const ClearanceCheck& check) {
+  const CopperLayer& layer = check.input->layers.at(check.layerIndex);
+  if (check.copperToCopper) {
+    return checkCopperCopperClearances(*check.input, layer);  // can throw
+  } else {
+    return checkCopperBoardClearances(*check.input, layer);  // can throw
+  }
+}
+
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkForMissingConnections() const {
+  QList<BoardDesignRuleCheckMessage> messages;
 
   // No check based on copper paths implemented yet -> return existing airwires
   // instead.
-  mBoard.forceAirWiresRebuild();
   foreach (const BI_AirWire* airwire, mBoard.getAirWires()) {
     QString msg =
         QString(tr("Missing connection: '%1'", "Placeholder is net name"))
             .arg(*airwire->getNetSignal().getName());
     Path location = Path::obround(airwire->getP1(), airwire->getP2(),
                                   PositiveLength(50000));
-    addMessage(BoardDesignRuleCheckMessage(msg, location));
+    messages.append(BoardDesignRuleCheckMessage(msg, location));
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
-                                                      int progressEnd) {
-  emit progressStatus(tr("Check board clearances..."));
-
-  qreal             progressSpan = progressEnd - progressStart;
+void BoardDesignRuleCheck::prepareCopperPaths() {
   QList<NetSignal*> netsignals =
       mBoard.getProject().getCircuit().getNetSignals().values();
   netsignals.append(nullptr);  // also check unconnected copper objects
 
-  // Board outline
-  ClipperLib::Paths outlineRestrictedArea;
-  {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addBoardOutline();
-    outlineRestrictedArea               = gen.getPaths();
-    ClipperLib::Paths outlinePathsInner = gen.getPaths();
-    ClipperHelpers::offset(
-        outlinePathsInner,
-        *maxArcTolerance() - *mOptions.minCopperBoardClearance,
-        maxArcTolerance());
-    ClipperHelpers::subtract(outlineRestrictedArea, outlinePathsInner);
-  }
+  // Restricted area along the board outline and around holes
+  QFuture<ClipperLib::Paths> outlineRestrictedArea =
+      QtConcurrent::run([this]() {
+        ClipperLib::Paths         area;
+        BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+        gen.addBoardOutline();
+        area                                = gen.getPaths();
+        ClipperLib::Paths outlinePathsInner = gen.getPaths();
+        ClipperHelpers::offset(
+            outlinePathsInner,
+            *maxArcTolerance() - *mOptions.minCopperBoardClearance,
+            maxArcTolerance());
+        ClipperHelpers::subtract(area, outlinePathsInner);
+        BoardClipperPathGenerator holesGen(mBoard, maxArcTolerance());
+        holesGen.addHoles(*mOptions.minCopperNpthClearance -
+                          *maxArcTolerance());
+        ClipperHelpers::unite(area, holesGen.getPaths());
+        return area;
+      });
 
-  // Holes
-  {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addHoles(*mOptions.minCopperNpthClearance - *maxArcTolerance());
-    ClipperHelpers::unite(outlineRestrictedArea, gen.getPaths());
+  // Copper paths of each net signal on each copper layer, except the ones
+  // which are still cached from the previous run
+  QSet<const NetSignal*> existingNetSignals;
+  foreach (const NetSignal* netsignal, netsignals) {
+    existingNetSignals.insert(netsignal);
   }
-
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
+  QHash<const GraphicsLayer*,
+        QFuture<QHash<const NetSignal*, ClipperLib::Paths>>>
+      copperPaths;
+  foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
     if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
       continue;
     }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersect(outlineRestrictedArea,
-                                    getCopperPaths(layer, netsignals[i]));
-      for (const ClipperLib::Path& path :
-           ClipperHelpers::flattenTree(*intersections)) {
-        QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-        QString msg   = QString(tr("Clearance (%1): '%2' <-> Board Outline",
-                                 "Placeholders are layer name + net name"))
-                          .arg(layer->getNameTr(), name1);
-        Path location = ClipperHelpers::convert(path);
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+    QHash<const NetSignal*, ClipperLib::Paths>& cache = mCachedPaths[layer];
+    for (auto it = cache.begin(); it != cache.end();) {
+      if (existingNetSignals.contains(it.key())) {
+        ++it;
+      } else {
+        it = cache.erase(it);  // net signal does no longer exist
       }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
     }
+    QList<const NetSignal*> missingNetSignals;
+    foreach (const NetSignal* netsignal, existingNetSignals) {
+      if (!cache.contains(netsignal)) {
+        missingNetSignals.append(netsignal);
+      }
+    }
+    if (missingNetSignals.isEmpty()) {
+      continue;
+    }
+    copperPaths.insert(
+        layer, QtConcurrent::run([this, layer, missingNetSignals]() {
+          QHash<const NetSignal*, ClipperLib::Paths> paths;
+          foreach (const NetSignal* netsignal, missingNetSignals) {
+            BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+            gen.addCopper(layer->getName(), netsignal);
+            paths.insert(netsignal, gen.getPaths());
+          }
+          return paths;
+        }));
+  }
+
+  // Wait for all workers to be finished before throwing any exception.
+  try {
+    outlineRestrictedArea.waitForFinished();
+  } catch (...) {
+  }
+  for (auto it = copperPaths.begin(); it != copperPaths.end(); ++it) {
+    try {
+      it.value().waitForFinished();
+    } catch (...) {
+    }
+  }
+  mOutlineRestrictedArea = outlineRestrictedArea.result();  // can throw
+  for (auto it = copperPaths.begin(); it != copperPaths.end(); ++it) {
+    mCachedPaths[it.key()].unite(it.value().result());  // can throw
   }
 }
 
-void BoardDesignRuleCheck::checkCopperCopperClearances(int progressStart,
-                                                       int progressEnd) {
-  emit progressStatus(tr("Check copper clearances..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkCopperBoardClearances(
+        const ClearanceCheckInput& input, const CopperLayer& layer) {
+  QList<BoardDesignRuleCheckMessage> messages;
 
-  qreal             progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
+  for (int i = 0; i < input.netsignals.count(); ++i) {
+    const ClipperLib::Paths& paths = getCopperPaths(layer, input.netsignals[i]);
+    if (!isInCheckArea(input.checkArea, ClipperHelpers::getBounds(paths))) {
+      continue;
+    }
+    std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersect(input.outlineRestrictedArea,
+                                  clipToCheckArea(input, paths));
+    for (const ClipperLib::Path& path :
+         ClipperHelpers::flattenTree(*intersections)) {
+      QString msg = QString(tr("Clearance (%1): '%2' <-> Board Outline",
+                               "Placeholders are layer name + net name"))
+                        .arg(layer.nameTr, input.netNames[i]);
+      Path location = ClipperHelpers::convert(path);
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
+    }
+  }
 
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
+  return messages;
+}
+
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkCopperCopperClearances(
+        const ClearanceCheckInput& input, const CopperLayer& layer) {
+  QList<BoardDesignRuleCheckMessage> messages;
+
+  // Offset the copper of each net only once and determine its bounding box.
+  // Nets which are completely outside of the area to check can be skipped,
+  // and of the other nets only the copper around this area is needed.
+  Length              offset = *input.options.minCopperCopperClearance / 2;
+  QVector<CopperArea> areas;
+  for (int i = 0; i < input.netsignals.count(); ++i) {
+    const ClipperLib::Paths& copper =
+        getCopperPaths(layer, input.netsignals[i]);
+    if (copper.empty()) {
       continue;
     }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      ClipperLib::Paths paths1 = getCopperPaths(layer, netsignals[i]);
-      ClipperHelpers::offset(
-          paths1, (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-          maxArcTolerance());
-      for (int k = i + 1; k < netsignals.count(); ++k) {
-        ClipperLib::Paths paths2 = getCopperPaths(layer, netsignals[k]);
-        ClipperHelpers::offset(
-            paths2,
-            (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-            maxArcTolerance());
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-          QString name2 = netsignals[k] ? *netsignals[k]->getName() : "";
-          QString msg   = QString(tr("Clearance (%1): '%2' <-> '%3'",
-                                   "Placeholders are layer name + net names"))
-                            .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
-      }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
+    ClipperLib::IntRect bounds = ClipperHelpers::getBounds(copper);
+    bounds.left -= offset.toNm();
+    bounds.top -= offset.toNm();
+    bounds.right += offset.toNm();
+    bounds.bottom += offset.toNm();
+    if (!isInCheckArea(input.checkArea, bounds)) {
+      continue;
+    }
+    ClipperLib::Paths paths = clipToCheckArea(input, copper);
+    if (paths.empty()) {
+      continue;
     }
+    ClipperHelpers::offset(
+        paths,
+        (*input.options.minCopperCopperClearance - *maxArcTolerance()) / 2,
+        maxArcTolerance());
+    areas.append(CopperArea{i, paths, ClipperHelpers::getBounds(paths)});
   }
+
+  // Broad phase: only pairs of nets with overlapping bounding boxes can
+  // violate the clearance, so find them with a sweep along the x-axis.
+  QVector<QPair<int, int>> candidates = findOverlappingAreas(areas);
+
+  // Narrow phase: intersect the copper areas of all candidate pairs.
+  for (int c = 0; c < candidates.count(); ++c) {
+    const CopperArea& area1 = areas[candidates[c].first];
+    const CopperArea& area2 = areas[candidates[c].second];
+    const QString&    name1 = input.netNames[area1.netIndex];
+    const QString&    name2 = input.netNames[area2.netIndex];
+
+    std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersect(area1.paths, area2.paths);
+    for (const ClipperLib::Path& path :
+         ClipperHelpers::flattenTree(*intersections)) {
+      QString msg = QString(tr("Clearance (%1): '%2' <-> '%3'",
+                               "Placeholders are layer name + net names"))
+                        .arg(layer.nameTr, name1, name2);
+      Path location = ClipperHelpers::convert(path);
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
+    }
+  }
+
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkCourtyardClearances(int progressStart,
-                                                    int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check courtyard clearances..."));
+ClipperLib::Paths BoardDesignRuleCheck::clipToCheckArea(
+    const ClearanceCheckInput& input, const ClipperLib::Paths& paths) {
+  if (!input.checkArea) {
+    return paths;  // whole board
+  }
+  std::unique_ptr<ClipperLib::PolyTree> tree =
+      ClipperHelpers::intersect(paths, input.checkAreaPaths);  // can throw
+  return ClipperHelpers::flattenTree(*tree);                  // can throw
+}
 
-  auto layers = mBoard.getLayerStack().getLayers(
-      {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
-  foreach (const GraphicsLayer* layer, layers) {
-    // determine device courtyard areas
-    QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
-    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, layer);
-      ClipperHelpers::offset(paths, mOptions.courtyardOffset,
-                             maxArcTolerance());
-      deviceCourtyards.insert(device, paths);
-    }
-
-    // check clearances
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
-      Q_ASSERT(dev1);
-      const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
-        Q_ASSERT(dev2);
-        const ClipperLib::Paths&              paths2 = deviceCourtyards[dev2];
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = *dev1->getComponentInstance().getName();
-          QString name2 = *dev2->getComponentInstance().getName();
-          QString msg =
-              QString(tr("Clearance (%1): '%2' <-> '%3'",
-                         "Placeholders are layer name + component names"))
-                  .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
+const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
+    const CopperLayer& layer, const NetSignal* netsignal) {
+  auto it = layer.paths.constFind(netsignal);
+  if (it == layer.paths.constEnd()) {
+    throw LogicError(__FILE__, __LINE__);
+  }
+  return *it;
+}
+
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkCourtyardClearances(
+        const GraphicsLayer& layer) const {
+  QList<BoardDesignRuleCheckMessage> messages;
+
+  // determine device courtyard areas
+  QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, &layer);
+    ClipperHelpers::offset(paths, mOptions.courtyardOffset, maxArcTolerance());
+    deviceCourtyards.insert(device, paths);
+  }
+
+  // check clearances
+  for (int i = 0; i < deviceCourtyards.count(); ++i) {
+    const BI_Device* dev1 = deviceCourtyards.keys()[i];
+    Q_ASSERT(dev1);
+    const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
+    for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
+      const BI_Device* dev2 = deviceCourtyards.keys()[k];
+      Q_ASSERT(dev2);
+      const ClipperLib::Paths&              paths2 = deviceCourtyards[dev2];
+      std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(paths1, paths2);
+      for (const ClipperLib::Path& path :
+           ClipperHelpers::flattenTree(*intersections)) {
+        QString name1 = *dev1->getComponentInstance().getName();
+        QString name2 = *dev2->getComponentInstance().getName();
+        QString msg =
+            QString(tr("Clearance (%1): '%2' <-> '%3'",
+                       "Placeholders are layer name + component names"))
+                .arg(layer.getNameTr(), name1, name2);
+        Path location = ClipperHelpers::convert(path);
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
-                                                   int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum copper width..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkMinimumCopperWidth() const {
+  QList<BoardDesignRuleCheckMessage> messages;
 
   // stroke texts
   foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
@@ -300,7 +621,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
         locations += path.toOutlineStrokes(PositiveLength(
             qMax(*text->getText().getStrokeWidth(), Length(50000))));
       }
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+      messages.append(BoardDesignRuleCheckMessage(msg, locations));
     }
   }
 
@@ -319,7 +640,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
       QVector<Path> locations =
           plane->getOutline().toClosedPath().toOutlineStrokes(
               PositiveLength(200000));
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+      messages.append(BoardDesignRuleCheckMessage(msg, locations));
     }
   }
 
@@ -346,7 +667,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
           locations += path.toOutlineStrokes(PositiveLength(
               qMax(*text->getText().getStrokeWidth(), Length(50000))));
         }
-        addMessage(BoardDesignRuleCheckMessage(msg, locations));
+        messages.append(BoardDesignRuleCheckMessage(msg, locations));
       }
     }
   }
@@ -366,18 +687,17 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
         Path location = Path::obround(netline->getStartPoint().getPosition(),
                                       netline->getEndPoint().getPosition(),
                                       netline->getWidth());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
-                                                   int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH restrings..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkMinimumPthRestring() const {
+  QList<BoardDesignRuleCheckMessage> messages;
 
   // vias
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
@@ -392,7 +712,7 @@ void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
                                   mOptions.minPthRestring +
                                   mOptions.minPthRestring;
         Path location = Path::circle(diameter).translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
@@ -417,18 +737,17 @@ void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
             PositiveLength(pad->getLibPad().getDrillDiameter() + 1) +
             mOptions.minPthRestring + mOptions.minPthRestring;
         Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
-                                                        int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH drill diameters..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkMinimumPthDrillDiameter() const {
+  QList<BoardDesignRuleCheckMessage> messages;
 
   // vias
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
@@ -440,7 +759,7 @@ void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
                                formatLength(*via->getDrillDiameter()));
         Path location = Path::circle(via->getDrillDiameter())
                             .translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
@@ -462,18 +781,17 @@ void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
         PositiveLength diameter(
             qMax(*pad->getLibPad().getDrillDiameter(), Length(50000)));
         Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
-                                                         int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum NPTH drill diameters..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkMinimumNpthDrillDiameter() const {
+  QList<BoardDesignRuleCheckMessage> messages;
 
   QString msgTr = tr("Min. hole diameter: %1", "Placeholder is drill diameter");
 
@@ -483,7 +801,7 @@ void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
       QString msg = msgTr.arg(formatLength(*hole->getHole().getDiameter()));
       Path    location = Path::circle(hole->getHole().getDiameter())
                           .translated(hole->getPosition());
-      addMessage(BoardDesignRuleCheckMessage(msg, location));
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
     }
   }
 
@@ -496,26 +814,16 @@ void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
         Path    location =
             Path::circle(hole.getDiameter())
                 .translated(footprint.mapToScene(hole.getPosition()));
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
-}
-
-const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
-    const GraphicsLayer* layer, const NetSignal* netsignal) {
-  if (!mCachedPaths[layer].contains(netsignal)) {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addCopper(layer->getName(), netsignal);
-    mCachedPaths[layer][netsignal] = gen.getPaths();
-  }
-  return mCachedPaths[layer][netsignal];
+  return messages;
 }
 
 ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
-    const BI_Device& device, const GraphicsLayer* layer) {
+    const BI_Device& device, const GraphicsLayer* layer) const {
   ClipperLib::Paths paths;
   for (const Polygon& polygon : device.getLibFootprint().getPolygons()) {
     QString polygonLayer = *polygon.getLayerName();
@@ -551,6 +859,202 @@ ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
   return paths;
 }
 
+void BoardDesignRuleCheck::boardItemModified(BI_Base& item) noexcept {
+  BI_Base* checkedItem = &item;
+  switch (item.getType()) {
+    case BI_Base::Type_t::Footprint:
+      checkedItem = &static_cast<BI_Footprint&>(item).getDeviceInstance();
+      break;
+    case BI_Base::Type_t::FootprintPad:
+      checkedItem = &static_cast<BI_FootprintPad&>(item)
+                         .getFootprint()
+                         .getDeviceInstance();
+      break;
+    case BI_Base::Type_t::NetSegment:
+    case BI_Base::Type_t::NetPoint:
+    case BI_Base::Type_t::AirWire:
+      return;  // no copper, or already reported by the attached netlines
+    default:
+      break;
+  }
+  mModifiedItems.insert(checkedItem, checkedItem);
+}
+
+QHash<const BI_Base*, BoardDesignRuleCheck::ItemState>
+    BoardDesignRuleCheck::getItemStates() const noexcept {
+  QHash<const BI_Base*, ItemState> states;
+  auto addItem = [this, &states](const BI_Base& item) {
+    if (tl::optional<ItemState> state = getItemState(item)) {
+      states.insert(&item, *state);
+    }
+  };
+
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    addItem(*device);
+    const BI_Footprint& footprint = device->getFootprint();
+    foreach (const BI_StrokeText* text, footprint.getStrokeTexts()) {
+      addItem(*text);
+    }
+  }
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_Via* via, netsegment->getVias()) { addItem(*via); }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      addItem(*netline);
+    }
+  }
+  foreach (const BI_Plane* plane, mBoard.getPlanes()) { addItem(*plane); }
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    addItem(*polygon);
+  }
+  foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
+    addItem(*text);
+  }
+  foreach (const BI_Hole* hole, mBoard.getHoles()) { addItem(*hole); }
+  return states;
+}
+
+tl::optional<BoardDesignRuleCheck::ItemState>
+    BoardDesignRuleCheck::getItemState(const BI_Base& item) const noexcept {
+  if (!item.isAddedToBoard()) {
+    return tl::nullopt;
+  }
+
+  ItemState state;
+  QRectF    rectPx;
+  switch (item.getType()) {
+    case BI_Base::Type_t::Device: {
+      const BI_Footprint& footprint =
+          static_cast<const BI_Device&>(item).getFootprint();
+      rectPx = footprint.getGrabAreaScenePx().boundingRect();
+      state.netsignals.append(nullptr);  // polygons, circles, texts
+      foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+        state.netsignals.append(pad->getCompSigInstNetSignal());
+        rectPx |= pad->getGrabAreaScenePx().boundingRect();
+      }
+      break;
+    }
+    case BI_Base::Type_t::Via:
+      rectPx = item.getGrabAreaScenePx().boundingRect();
+      state.netsignals.append(
+          &static_cast<const BI_Via&>(item).getNetSegment().getNetSignal());
+      break;
+    case BI_Base::Type_t::NetLine:
+      rectPx = item.getGrabAreaScenePx().boundingRect();
+      state.netsignals.append(&static_cast<const BI_NetLine&>(item)
+                                   .getNetSegment()
+                                   .getNetSignal());
+      break;
+    case BI_Base::Type_t::Plane:
+      rectPx = item.getGrabAreaScenePx().boundingRect();
+      state.netsignals.append(
+          &static_cast<const BI_Plane&>(item).getNetSignal());
+      break;
+    case BI_Base::Type_t::Polygon:
+    case BI_Base::Type_t::StrokeText:
+      rectPx = item.getGrabAreaScenePx().boundingRect();
+      state.netsignals.append(nullptr);
+      break;
+    case BI_Base::Type_t::Hole:
+      rectPx = item.getGrabAreaScenePx().boundingRect();
+      break;
+    default:
+      return tl::nullopt;
+  }
+  state.bounds = toBounds(rectPx);
+  return state;
+}
+
+void BoardDesignRuleCheck::updateCheckArea() noexcept {
+  if (!mIncrementalStateValid) {
+    // Without a previous run, the whole board needs to be checked.
+    mCheckArea = tl::nullopt;
+    mCachedPaths.clear();
+    mAreaMessages.clear();
+    mItemStates = getItemStates();
+    mModifiedItems.clear();
+    return;
+  }
+
+  // Determine the old and new areas of all modified items. Only the states of
+  // these items are updated, all other items are not touched at all.
+  QVector<ClipperLib::IntRect> area;
+  QSet<const NetSignal*>       netsignals;
+
+  auto addItem = [&area, &netsignals](const ItemState& state) {
+    area.append(state.bounds);
+    foreach (const NetSignal* netsignal, state.netsignals) {
+      netsignals.insert(netsignal);
+    }
+  };
+  for (auto it = mModifiedItems.constBegin(); it != mModifiedItems.constEnd();
+       ++it) {
+    auto previous = mItemStates.find(it.key());
+    if (previous != mItemStates.end()) {
+      addItem(previous.value());
+      mItemStates.erase(previous);
+    }
+    if (const BI_Base* item = it.value().data()) {
+      if (tl::optional<ItemState> state = getItemState(*item)) {
+        addItem(*state);
+        mItemStates.insert(item, *state);
+      }
+    }
+  }
+  mModifiedItems.clear();
+
+  // Violations may also be located a bit around the modified items.
+  Length margin = qMax(*mOptions.minCopperCopperClearance,
+                       qMax(*mOptions.minCopperBoardClearance,
+                            *mOptions.minCopperNpthClearance)) +
+                  *maxArcTolerance();
+  for (ClipperLib::IntRect& rect : area) {
+    rect.left -= margin.toNm();
+    rect.top -= margin.toNm();
+    rect.right += margin.toNm();
+    rect.bottom += margin.toNm();
+  }
+  mCheckArea = area;
+
+  // The copper of the affected net signals needs to be determined again.
+  for (auto it = mCachedPaths.begin(); it != mCachedPaths.end(); ++it) {
+    foreach (const NetSignal* netsignal, netsignals) {
+      it.value().remove(netsignal);
+    }
+  }
+}
+
+bool BoardDesignRuleCheck::isInCheckArea(
+    const tl::optional<QVector<ClipperLib::IntRect>>& checkArea,
+    const ClipperLib::IntRect&                        bounds) noexcept {
+  if (!checkArea) {
+    return true;  // whole board
+  }
+  foreach (const ClipperLib::IntRect& rect, *checkArea) {
+    if (ClipperHelpers::boundsOverlap(rect, bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BoardDesignRuleCheck::isInCheckArea(
+    const BoardDesignRuleCheckMessage& msg) const noexcept {
+  ClipperLib::Paths paths;
+  foreach (const Path& path, msg.getLocations()) {
+    paths.push_back(ClipperHelpers::convert(path, maxArcTolerance()));
+  }
+  return isInCheckArea(mCheckArea, ClipperHelpers::getBounds(paths));
+}
+
+ClipperLib::IntRect BoardDesignRuleCheck::toBounds(
+    const QRectF& rectPx) noexcept {
+  Point p1 = Point::fromPx(rectPx.topLeft());
+  Point p2 = Point::fromPx(rectPx.bottomRight());
+  return ClipperLib::IntRect{
+      qMin(p1.getX(), p2.getX()).toNm(), qMin(p1.getY(), p2.getY()).toNm(),
+      qMax(p1.getX(), p2.getX()).toNm(), qMax(p1.getY(), p2.getY()).toNm()};
+}
+
 void BoardDesignRuleCheck::addMessage(
     const BoardDesignRuleCheckMessage& msg) noexcept {
   mMessages.append(msg);
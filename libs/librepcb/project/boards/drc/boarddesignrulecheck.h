@@ -26,9 +26,12 @@
 #include "boarddesignrulecheckmessage.h"
 
 #include <clipper/clipper.hpp>
+#include <optional/tl/optional.hpp>
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -39,6 +42,7 @@ class GraphicsLayer;
 namespace project {
 
 class Board;
+class BI_Base;
 class BI_Device;
 class NetSignal;
 
@@ -49,6 +53,16 @@ class NetSignal;
 /**
  * @brief The BoardDesignRuleCheck class checks a ::librepcb::project::Board for
  *        design rule violations
+ *
+ * Checks which only read from the board are executed concurrently on the
+ * global thread pool, but the messages are always reported in the same order.
+ *
+ * After a first run, #startIncremental() can be used to re-check only the
+ * areas around the items which were modified since the previous run (as
+ * reported by ::librepcb::project::Board::itemModified()). The messages of all
+ * other areas are taken from the previous run. The copper clearances of an
+ * incremental check are checked in the background, #finished() or #failed()
+ * is emitted afterwards.
  */
 class BoardDesignRuleCheck final : public QObject {
   Q_OBJECT
@@ -85,9 +99,13 @@ public:
   const QList<BoardDesignRuleCheckMessage>& getMessages() const noexcept {
     return mMessages;
   }
+  bool isRunning() const noexcept {
+    return mClearanceChecksWatcher.isRunning();
+  }
 
   // General Methods
   void execute();
+  void startIncremental();
 
 signals:
   void started();
@@ -95,21 +113,82 @@ signals:
   void progressStatus(const QString& msg);
   void progressMessage(const QString& msg);
   void finished();
+  void failed(const QString& errorMsg);
+
+private:  // Types
+  struct CopperArea {
+    int                 netIndex;
+    ClipperLib::Paths   paths;
+    ClipperLib::IntRect bounds;
+  };
+
+  struct ItemState {
+    ClipperLib::IntRect       bounds;
+    QVector<const NetSignal*> netsignals;
+  };
+
+  struct CopperLayer {
+    QString                                    nameTr;
+    QHash<const NetSignal*, ClipperLib::Paths> paths;
+  };
+
+  /// Copy of everything the clearance checks need from the board, so they can
+  /// be executed in worker threads while the board is modified
+  struct ClearanceCheckInput {
+    Options                                    options;
+    ClipperLib::Paths                          outlineRestrictedArea;
+    QVector<const NetSignal*>                  netsignals;
+    QVector<QString>                           netNames;
+    QVector<CopperLayer>                       layers;
+    tl::optional<QVector<ClipperLib::IntRect>> checkArea;
+    ClipperLib::Paths                          checkAreaPaths;
+  };
+
+  struct ClearanceCheck {
+    std::shared_ptr<const ClearanceCheckInput> input;
+    int                                        layerIndex;
+    bool                                       copperToCopper;
+  };
 
 private:  // Methods
   void rebuildPlanes(int progressStart, int progressEnd);
-  void checkForMissingConnections(int progressStart, int progressEnd);
-  void checkCopperBoardClearances(int progressStart, int progressEnd);
-  void checkCopperCopperClearances(int progressStart, int progressEnd);
-  void checkCourtyardClearances(int progressStart, int progressEnd);
-  void checkMinimumCopperWidth(int progressStart, int progressEnd);
-  void checkMinimumPthRestring(int progressStart, int progressEnd);
-  void checkMinimumPthDrillDiameter(int progressStart, int progressEnd);
-  void checkMinimumNpthDrillDiameter(int progressStart, int progressEnd);
-  const ClipperLib::Paths& getCopperPaths(const GraphicsLayer* layer,
-                                          const NetSignal*     netsignal);
-  ClipperLib::Paths        getDeviceCourtyardPaths(const BI_Device&     device,
-                                                   const GraphicsLayer* layer);
+  QList<BoardDesignRuleCheckMessage> checkForMissingConnections() const;
+  void                               prepareCopperPaths();
+  QFuture<QList<BoardDesignRuleCheckMessage>> runChecks();
+  void finishChecks(const QFuture<QList<BoardDesignRuleCheckMessage>>& result);
+  void clearanceChecksFinished() noexcept;
+  std::shared_ptr<const ClearanceCheckInput> getClearanceCheckInput() const;
+  static QList<BoardDesignRuleCheckMessage> checkClearances(
+      const ClearanceCheck& check);
+  static QList<BoardDesignRuleCheckMessage> checkCopperBoardClearances(
+      const ClearanceCheckInput& input, const CopperLayer& layer);
+  static QList<BoardDesignRuleCheckMessage> checkCopperCopperClearances(
+      const ClearanceCheckInput& input, const CopperLayer& layer);
+  static ClipperLib::Paths clipToCheckArea(const ClearanceCheckInput& input,
+                                           const ClipperLib::Paths&   paths);
+  static const ClipperLib::Paths& getCopperPaths(const CopperLayer& layer,
+                                                 const NetSignal*   netsignal);
+  QList<BoardDesignRuleCheckMessage> checkCourtyardClearances(
+      const GraphicsLayer& layer) const;
+  QList<BoardDesignRuleCheckMessage> checkMinimumCopperWidth() const;
+  QList<BoardDesignRuleCheckMessage> checkMinimumPthRestring() const;
+  QList<BoardDesignRuleCheckMessage> checkMinimumPthDrillDiameter() const;
+  QList<BoardDesignRuleCheckMessage> checkMinimumNpthDrillDiameter() const;
+
+  static QVector<QPair<int, int>> findOverlappingAreas(
+      const QVector<CopperArea>& areas) noexcept;
+  ClipperLib::Paths getDeviceCourtyardPaths(const BI_Device&     device,
+                                            const GraphicsLayer* layer) const;
+  void boardItemModified(BI_Base& item) noexcept;
+  QHash<const BI_Base*, ItemState> getItemStates() const noexcept;
+  tl::optional<ItemState>          getItemState(const BI_Base& item) const
+      noexcept;
+  void updateCheckArea() noexcept;
+  bool isInCheckArea(const BoardDesignRuleCheckMessage& msg) const noexcept;
+  static bool isInCheckArea(
+      const tl::optional<QVector<ClipperLib::IntRect>>& checkArea,
+      const ClipperLib::IntRect&                        bounds) noexcept;
+  static ClipperLib::IntRect toBounds(const QRectF& rectPx) noexcept;
   void    addMessage(const BoardDesignRuleCheckMessage& msg) noexcept;
   QString formatLength(const Length& length) const noexcept;
 
@@ -124,8 +203,27 @@ private:  // Data
   Board&                             mBoard;
   Options                            mOptions;
   QList<BoardDesignRuleCheckMessage> mMessages;
+  ClipperLib::Paths                  mOutlineRestrictedArea;
   QHash<const GraphicsLayer*, QHash<const NetSignal*, ClipperLib::Paths>>
       mCachedPaths;
+
+  // State of the previous run, used by #startIncremental()
+  QHash<const BI_Base*, ItemState>   mItemStates;
+  QList<BoardDesignRuleCheckMessage> mAreaMessages;
+  bool                               mIncrementalStateValid;
+
+  /// Items modified since the previous run (the value becomes nullptr if the
+  /// item gets deleted, but the key is still needed to find its old state)
+  QHash<const BI_Base*, QPointer<BI_Base>> mModifiedItems;
+
+  /// Area to be checked, or tl::nullopt to check the whole board
+  tl::optional<QVector<ClipperLib::IntRect>> mCheckArea;
+
+  /// Messages of the checks which were already executed, while the clearance
+  /// checks are still running
+  QList<BoardDesignRuleCheckMessage> mPendingAreaMessages;
+  QList<BoardDesignRuleCheckMessage> mPendingMessages;
+  QFutureWatcher<QList<BoardDesignRuleCheckMessage>> mClearanceChecksWatcher;
 };
 
 /*******************************************************************************
@@ -76,16 +76,18 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept {
 
   mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
   mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-  mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-  mBoundingRect.adjust(
-      -mNetLine.getWidth()->toPx() / 2, -mNetLine.getWidth()->toPx() / 2,
-      mNetLine.getWidth()->toPx() / 2, mNetLine.getWidth()->toPx() / 2);
+  // Note: The shape has a minimum width to keep very thin lines selectable.
+  // The bounding rect must contain the whole shape since it is used by the
+  // spatial index of the graphics scene for hit testing.
+  PositiveLength width = qMax(mNetLine.getWidth(), PositiveLength(100000));
+  mBoundingRect        = QRectF(mLineF.p1(), mLineF.p2()).normalized();
+  mBoundingRect.adjust(-width->toPx() / 2, -width->toPx() / 2,
+                       width->toPx() / 2, width->toPx() / 2);
   mShape = QPainterPath();
   mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
   mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
   QPainterPathStroker ps;
   ps.setCapStyle(Qt::RoundCap);
-  PositiveLength width = qMax(mNetLine.getWidth(), PositiveLength(100000));
   ps.setWidth(width->toPx());
   mShape = ps.createStroke(mShape);
   update();
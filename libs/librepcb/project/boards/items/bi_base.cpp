@@ -75,9 +75,11 @@ void BI_Base::setSelected(bool selected) noexcept {
 void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToBoard);
   if (item) {
+    item->setData(sGraphicsItemDataKey, QVariant::fromValue(this));
     mBoard.getGraphicsScene().addItem(*item);
   }
   mIsAddedToBoard = true;
+  mBoard.notifyItemModified(*this);
 }
 
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
@@ -86,6 +88,21 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
     mBoard.getGraphicsScene().removeItem(*item);
   }
   mIsAddedToBoard = false;
+  mBoard.notifyItemModified(*this);
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BI_Base* BI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  for (const QGraphicsItem* i = &item; i; i = i->parentItem()) {
+    if (BI_Base* boardItem =
+            qvariant_cast<BI_Base*>(i->data(sGraphicsItemDataKey))) {
+      return boardItem;
+    }
+  }
+  return nullptr;
 }
 
 /*******************************************************************************
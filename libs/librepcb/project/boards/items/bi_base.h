@@ -97,6 +97,19 @@ public:
   // Operator Overloadings
   BI_Base& operator=(const BI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the board item to which a graphics item belongs
+   *
+   * @param item    A graphics item of the board's graphics scene, or one of
+   *                its child items.
+   *
+   * @return The board item which added the graphics item to the board, or
+   *         nullptr if there is no such board item.
+   */
+  static BI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToBoard(QGraphicsItem* item) noexcept;
@@ -106,6 +119,9 @@ protected:
   Board& mBoard;
 
 private:
+  /// Key of the graphics item data which points to the board item
+  static const int sGraphicsItemDataKey = 0;
+
   // General Attributes
   bool mIsAddedToBoard;
   bool mIsSelected;
@@ -199,6 +199,7 @@ void BI_Device::setPosition(const Point& pos) noexcept {
   if (pos != mPosition) {
     mPosition = pos;
     emit moved(mPosition);
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -206,6 +207,7 @@ void BI_Device::setRotation(const Angle& rot) noexcept {
   if (rot != mRotation) {
     mRotation = rot;
     emit rotated(mRotation);
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -216,6 +218,7 @@ void BI_Device::setIsMirrored(bool mirror) {
     }
     mIsMirrored = mirror;
     emit mirrored(mIsMirrored);
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -236,6 +236,7 @@ void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
   }
   mBoard.scheduleAirWiresRebuild(from);
   mBoard.scheduleAirWiresRebuild(to);
+  mBoard.notifyItemModified(*this);
 }
 
 /*******************************************************************************
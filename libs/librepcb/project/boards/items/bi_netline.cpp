@@ -210,6 +210,7 @@ void BI_NetLine::setLayer(GraphicsLayer& layer) {
   if (&layer != mLayer) {
     mLayer = &layer;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -217,6 +218,7 @@ void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -257,6 +259,7 @@ void BI_NetLine::removeFromBoard() {
 void BI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
   mGraphicsItem->updateCacheAndRepaint();
+  mBoard.notifyItemModified(*this);
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
@@ -104,6 +104,7 @@ void BI_NetPoint::setPosition(const Point& position) noexcept {
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     foreach (BI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -244,6 +244,7 @@ void BI_NetSegment::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mBoard.notifyItemModified(*this);
   }
 }
 
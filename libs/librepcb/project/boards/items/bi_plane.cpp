@@ -25,7 +25,6 @@
 #include "../../circuit/circuit.h"
 #include "../../circuit/netsignal.h"
 #include "../../project.h"
-#include "../boardplanefragmentsbuilder.h"
 #include "../graphicsitems/bgi_plane.h"
 
 #include <librepcb/common/scopeguard.h>
@@ -130,6 +129,7 @@ void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -137,6 +137,7 @@ void BI_Plane::setLayerName(const GraphicsLayerName& layerName) noexcept {
   if (layerName != mLayerName) {
     mLayerName = layerName;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -152,36 +153,42 @@ void BI_Plane::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mBoard.notifyItemModified(*this);
   }
 }
 
 void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
   if (minWidth != mMinWidth) {
     mMinWidth = minWidth;
+    mBoard.notifyItemModified(*this);
   }
 }
 
 void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
   if (minClearance != mMinClearance) {
     mMinClearance = minClearance;
+    mBoard.notifyItemModified(*this);
   }
 }
 
 void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
   if (style != mConnectStyle) {
     mConnectStyle = style;
+    mBoard.notifyItemModified(*this);
   }
 }
 
 void BI_Plane::setPriority(int priority) noexcept {
   if (priority != mPriority) {
     mPriority = priority;
+    mBoard.notifyItemModified(*this);
   }
 }
 
 void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
   if (keepOrphans != mKeepOrphans) {
     mKeepOrphans = keepOrphans;
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -220,9 +227,8 @@ void BI_Plane::clear() noexcept {
   mGraphicsItem->updateCacheAndRepaint();
 }
 
-void BI_Plane::rebuild() noexcept {
-  BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept {
+  mFragments = fragments;
   mGraphicsItem->updateCacheAndRepaint();
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
@@ -104,7 +104,7 @@ public:
   void addToBoard() override;
   void removeFromBoard() override;
   void clear() noexcept;
-  void rebuild() noexcept;
+  void setFragments(const QVector<Path>& fragments) noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
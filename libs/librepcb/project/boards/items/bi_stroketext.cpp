@@ -190,6 +190,7 @@ void BI_StrokeText::strokeTextEdited(const StrokeText& text,
     default:
       break;
   }
+  mBoard.notifyItemModified(*this);
 }
 
 /*******************************************************************************
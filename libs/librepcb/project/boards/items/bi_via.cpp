@@ -141,6 +141,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
       netline->updateLine();
     }
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -148,6 +149,7 @@ void BI_Via::setShape(Shape shape) noexcept {
   if (shape != mShape) {
     mShape = shape;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -155,6 +157,7 @@ void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (size != mSize) {
     mSize = size;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -162,6 +165,7 @@ void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (diameter != mDrillDiameter) {
     mDrillDiameter = diameter;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.notifyItemModified(*this);
   }
 }
 
@@ -46,7 +46,8 @@ namespace project {
 Circuit::Circuit(Project& project, bool create)
   : QObject(&project),
     mProject(project),
-    mDirectory(new TransactionalDirectory(project.getDirectory(), "circuit")) {
+    mDirectory(new TransactionalDirectory(project.getDirectory(), "circuit")),
+    mIsModified(true) {
   qDebug() << "load circuit...";
 
   try {
@@ -60,22 +61,22 @@ Circuit::Circuit(Project& project, bool create)
       // OK - file is open --> now load the whole circuit stuff
 
       // Load all netclasses
-      foreach (const SExpression& node, root.getChildren("netclass")) {
+      root.forEachChild("netclass", [this](const SExpression& node) {
         NetClass* netclass = new NetClass(*this, node);
         addNetClass(*netclass);
-      }
+      });
 
       // Load all netsignals
-      foreach (const SExpression& node, root.getChildren("net")) {
+      root.forEachChild("net", [this](const SExpression& node) {
         NetSignal* netsignal = new NetSignal(*this, node);
         addNetSignal(*netsignal);
-      }
+      });
 
       // Load all component instances
-      foreach (const SExpression& node, root.getChildren("component")) {
+      root.forEachChild("component", [this](const SExpression& node) {
         ComponentInstance* component = new ComponentInstance(*this, node);
         addComponentInstance(*component);
-      }
+      });
     }
   } catch (...) {
     // free allocated memory (see comments in the destructor) and rethrow the
@@ -168,6 +169,7 @@ void Circuit::addNetClass(NetClass& netclass) {
   // add netclass to circuit
   netclass.addToCircuit();  // can throw
   mNetClasses.insert(netclass.getUuid(), &netclass);
+  notifyModified();
   emit netClassAdded(netclass);
 }
 
@@ -179,6 +181,7 @@ void Circuit::removeNetClass(NetClass& netclass) {
   // remove netclass from project
   netclass.removeFromCircuit();  // can throw
   mNetClasses.remove(netclass.getUuid());
+  notifyModified();
   emit netClassRemoved(netclass);
 }
 
@@ -256,6 +259,7 @@ void Circuit::addNetSignal(NetSignal& netsignal) {
   // add netsignal to circuit
   netsignal.addToCircuit();  // can throw
   mNetSignals.insert(netsignal.getUuid(), &netsignal);
+  notifyModified();
   emit netSignalAdded(netsignal);
 }
 
@@ -267,6 +271,7 @@ void Circuit::removeNetSignal(NetSignal& netsignal) {
   // remove netsignal from circuit
   netsignal.removeFromCircuit();  // can throw
   mNetSignals.remove(netsignal.getUuid());
+  notifyModified();
   emit netSignalRemoved(netsignal);
 }
 
@@ -343,6 +348,7 @@ void Circuit::addComponentInstance(ComponentInstance& cmp) {
   // add to circuit
   cmp.addToCircuit();  // can throw
   mComponentInstances.insert(cmp.getUuid(), &cmp);
+  notifyModified();
   emit componentAdded(cmp);
 }
 
@@ -354,6 +360,7 @@ void Circuit::removeComponentInstance(ComponentInstance& cmp) {
   // remove from circuit
   cmp.removeFromCircuit();  // can throw
   mComponentInstances.remove(cmp.getUuid());
+  notifyModified();
   emit componentRemoved(cmp);
 }
 
@@ -379,8 +386,12 @@ void Circuit::setComponentInstanceName(ComponentInstance&       cmp,
  ******************************************************************************/
 
 void Circuit::save() {
-  SExpression doc(serializeToDomElement("librepcb_circuit"));  // can throw
-  mDirectory->write("circuit.lp", doc.toByteArray());          // can throw
+  // only save the circuit if it was modified since the last save
+  if (mIsModified) {
+    SExpression doc(serializeToDomElement("librepcb_circuit"));  // can throw
+    mDirectory->write("circuit.lp", doc.toByteArray());          // can throw
+    mIsModified = false;
+  }
 }
 
 /*******************************************************************************
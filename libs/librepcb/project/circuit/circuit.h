@@ -122,6 +122,14 @@ public:
   void setComponentInstanceName(ComponentInstance&       cmp,
                                 const CircuitIdentifier& newName);
 
+  /**
+   * @brief Notify that the content of the circuit file was modified
+   *
+   * This is called by the circuit elements on every modification. #save()
+   * only serializes the circuit if it was modified since the last save.
+   */
+  void notifyModified() noexcept { mIsModified = true; }
+
   // General Methods
   void save();
 
@@ -146,6 +154,7 @@ private:
   // General
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   QScopedPointer<TransactionalDirectory> mDirectory;
+  bool                                   mIsModified;  ///< see #save()
 
   QMap<Uuid, NetClass*>          mNetClasses;
   QMap<Uuid, NetSignal*>         mNetSignals;
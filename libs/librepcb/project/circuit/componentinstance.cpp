@@ -223,6 +223,7 @@ void ComponentInstance::setName(const CircuitIdentifier& name) noexcept {
   if (name != mName) {
     mName = name;
     updateErcMessages();
+    mCircuit.notifyModified();
     emit attributesChanged();
   }
 }
@@ -230,6 +231,7 @@ void ComponentInstance::setName(const CircuitIdentifier& name) noexcept {
 void ComponentInstance::setValue(const QString& value) noexcept {
   if (value != mValue) {
     mValue = value;
+    mCircuit.notifyModified();
     emit attributesChanged();
   }
 }
@@ -238,6 +240,7 @@ void ComponentInstance::setAttributes(
     const AttributeList& attributes) noexcept {
   if (attributes != *mAttributes) {
     *mAttributes = attributes;
+    mCircuit.notifyModified();
     emit attributesChanged();
   }
 }
@@ -246,6 +249,7 @@ void ComponentInstance::setDefaultDeviceUuid(
     const tl::optional<Uuid>& device) noexcept {
   if (device != mDefaultDeviceUuid) {
     mDefaultDeviceUuid = device;
+    mCircuit.notifyModified();
     emit attributesChanged();
   }
 }
@@ -202,6 +202,7 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal) {
   mNetSignal     = netsignal;
   updateErcMessages();
   sgl.dismiss();
+  mCircuit.notifyModified();
   emit netSignalChanged(old, mNetSignal);
 }
 
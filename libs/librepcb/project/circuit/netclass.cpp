@@ -71,6 +71,7 @@ void NetClass::setName(const ElementName& name) noexcept {
   }
   mName = name;
   updateErcMessages();
+  mCircuit.notifyModified();
 }
 
 /*******************************************************************************
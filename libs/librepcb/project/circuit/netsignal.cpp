@@ -120,6 +120,7 @@ void NetSignal::setName(const CircuitIdentifier& name,
   mName        = name;
   mHasAutoName = isAutoName;
   updateErcMessages();
+  mCircuit.notifyModified();
   emit nameChanged(mName);
 }
 
@@ -33,6 +33,7 @@
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/sym/symbol.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -145,33 +146,67 @@ void ProjectLibrary::save() {
 template <typename ElementType>
 void ProjectLibrary::loadElements(const QString& dirname, const QString& type,
                                   QHash<Uuid, ElementType*>& elementList) {
-  // search all subdirectories which have a valid UUID as directory name
+  // Load all elements in worker threads since parsing their files takes most
+  // of the time when opening a project. Afterwards the elements are moved to
+  // the thread of the project library.
+  QThread*                     thread = this->thread();
+  QList<QFuture<ElementType*>> futures;
   foreach (const QString& sub, mDirectory->getDirs(dirname)) {
-    std::unique_ptr<TransactionalDirectory> dir(
-        new TransactionalDirectory(*mDirectory, dirname % "/" % sub));
-
-    // check if directory is a valid library element
-    if (!LibraryBaseElement::isValidElementDirectory<ElementType>(*dir, "")) {
-      qWarning() << "Found an invalid directory in the library:"
-                 << dir->getAbsPath().toNative();
-      continue;
+    // Note: The directory is created here to not access mDirectory from the
+    // worker threads. It is owned by the job and then by the created element,
+    // which is moved to the thread of the project library before returning.
+    TransactionalDirectory* dir =
+        new TransactionalDirectory(*mDirectory, dirname % "/" % sub);
+    futures.append(QtConcurrent::run([dir, thread]() -> ElementType* {
+      std::unique_ptr<TransactionalDirectory> dirPtr(dir);
+
+      // check if directory is a valid library element
+      if (!LibraryBaseElement::isValidElementDirectory<ElementType>(*dirPtr,
+                                                                    "")) {
+        qWarning() << "Found an invalid directory in the library:"
+                   << dirPtr->getAbsPath().toNative();
+        return nullptr;
+      }
+
+      // load the library element
+      ElementType* element = new ElementType(std::move(dirPtr));  // can throw
+      element->moveToThread(thread);
+      return element;
+    }));
+  }
+
+  // Wait for all jobs, even if one of them failed, to not leak any elements.
+  QList<ElementType*>        elements;
+  std::unique_ptr<Exception> error;
+  for (int i = 0; i < futures.count(); ++i) {
+    try {
+      if (ElementType* element = futures[i].result()) {  // can throw
+        elements.append(element);
+      }
+    } catch (const Exception& e) {
+      if (!error) error.reset(e.clone());
     }
+  }
+  if (error) {
+    qDeleteAll(elements);
+    error->raise();
+  }
 
-    // load the library element
-    QScopedPointer<ElementType> element(
-        new ElementType(std::move(dir)));  // can throw
+  // everything is ok -> update members
+  for (int i = 0; i < elements.count(); ++i) {
+    ElementType* element = elements.at(i);
     if (elementList.contains(element->getUuid())) {
+      FilePath fp = element->getDirectory().getAbsPath();
+      qDeleteAll(elements.mid(i));
       throw RuntimeError(
           __FILE__, __LINE__,
           QString("There are multiple library elements with the same "
                   "UUID in the directory \"%1\"")
-              .arg(dir->getAbsPath().toNative()));
+              .arg(fp.toNative()));
     }
-
-    // everything is ok -> update members
-    elementList.insert(element->getUuid(), element.data());
-    mElementsToUpgrade.insert(element.data());
-    mAllElements.insert(element.take());  // Take object from smart pointer!
+    elementList.insert(element->getUuid(), element);
+    mElementsToUpgrade.insert(element);
+    mAllElements.insert(element);
   }
 
   qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
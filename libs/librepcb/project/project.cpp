@@ -36,10 +36,12 @@
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/common/fileio/versionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
 
 #include <QPrinter>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -114,6 +116,13 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
   // allocated memory will be freed. Then the exception is rethrown to leave the
   // constructor.
 
+  // Futures of the schematic and board files which are parsed in worker
+  // threads, see below.
+  QStringList                 schematicDirs;
+  QList<QFuture<SExpression>> schematicFiles;
+  QStringList                 boardDirs;
+  QList<QFuture<SExpression>> boardFiles;
+
   try {
     // copy and/or load stroke fonts
     TransactionalDirectory fontobeneDir(*mDirectory, "resources/fontobene");
@@ -144,6 +153,34 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
       mProjectMetadata.reset(new ProjectMetadata(root));
     }
 
+    // Start reading and parsing the schematic and board files in worker
+    // threads while the library and the circuit are loaded, since this takes
+    // a lot of time for big projects. The schematics and boards themselves
+    // can only be created afterwards because they depend on the circuit.
+    if (!create) {
+      QString     fp = "schematics/schematics.lp";
+      SExpression schRoot =
+          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
+      foreach (const SExpression& node, schRoot.getChildren("schematic")) {
+        FilePath fp = FilePath::fromRelative(
+            getPath(), node.getValueOfFirstChild<QString>());
+        schematicDirs.append(fp.getParentDir().toRelative(getPath()));
+        schematicFiles.append(
+            parseFileAsync(schematicDirs.last() % "/schematic.lp"));
+      }
+    }
+    if (!create) {
+      QString     fp = "boards/boards.lp";
+      SExpression brdRoot =
+          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
+      foreach (const SExpression& node, brdRoot.getChildren("board")) {
+        FilePath fp = FilePath::fromRelative(
+            getPath(), node.getValueOfFirstChild<QString>());
+        boardDirs.append(fp.getParentDir().toRelative(getPath()));
+        boardFiles.append(parseFileAsync(boardDirs.last() % "/board.lp"));
+      }
+    }
+
     // Create all needed objects
     connect(mProjectMetadata.data(), &ProjectMetadata::attributesChanged, this,
             &Project::attributesChanged);
@@ -158,34 +195,26 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
     mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
     // Load all schematics
+    for (int i = 0; i < schematicDirs.count(); ++i) {
+      std::unique_ptr<TransactionalDirectory> dir(
+          new TransactionalDirectory(*mDirectory, schematicDirs.at(i)));
+      Schematic* schematic = new Schematic(
+          *this, std::move(dir), schematicFiles[i].result());  // can throw
+      addSchematic(*schematic);
+    }
     if (!create) {
-      QString     fp = "schematics/schematics.lp";
-      SExpression schRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, schRoot.getChildren("schematic")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Schematic* schematic = new Schematic(*this, std::move(dir));
-        addSchematic(*schematic);
-      }
       qDebug() << mSchematics.count() << "schematics successfully loaded!";
     }
 
     // Load all boards
+    for (int i = 0; i < boardDirs.count(); ++i) {
+      std::unique_ptr<TransactionalDirectory> dir(
+          new TransactionalDirectory(*mDirectory, boardDirs.at(i)));
+      Board* board = new Board(*this, std::move(dir),
+                               boardFiles[i].result());  // can throw
+      addBoard(*board);
+    }
     if (!create) {
-      QString     fp = "boards/boards.lp";
-      SExpression brdRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, brdRoot.getChildren("board")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Board* board = new Board(*this, std::move(dir));
-        addBoard(*board);
-      }
       qDebug() << mBoards.count() << "boards successfully loaded!";
     }
 
@@ -197,6 +226,14 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
 
     if (create) save();  // write all files to file system
   } catch (...) {
+    // Wait for all parser jobs since they keep the file system (and thus the
+    // directory lock) alive, which must be released before leaving here.
+    foreach (QFuture<SExpression> future, schematicFiles + boardFiles) {
+      try {
+        future.waitForFinished();  // can throw
+      } catch (...) {
+      }
+    }
     // free the allocated memory in the reverse order of their allocation...
     foreach (Board* board, mBoards) {
       try {
@@ -611,6 +648,23 @@ QString Project::getBuiltInAttributeValue(const QString& key) const noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QFuture<SExpression> Project::parseFileAsync(const QString& path) const
+    noexcept {
+  // Note: The job keeps the file system alive, so it's safe even if the
+  // project gets destroyed before the job is finished (e.g. if loading fails).
+  std::shared_ptr<const TransactionalFileSystem> fs =
+      mDirectory->getFileSystem();
+  QString fsPath = mDirectory->getPath() % "/" % path;
+  return QtConcurrent::run([fs, fsPath]() {
+    return SExpression::parse(fs->read(fsPath),
+                              fs->getAbsPath(fsPath));  // can throw
+  });
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -41,6 +41,7 @@ class QPrinter;
 
 namespace librepcb {
 
+class SExpression;
 class StrokeFontPool;
 
 namespace project {
@@ -462,6 +463,15 @@ private:
   explicit Project(std::unique_ptr<TransactionalDirectory> directory,
                    const QString& filename, bool create);
 
+  /**
+   * @brief Read and parse a file of the project in a worker thread
+   *
+   * @param path          The file path, relative to the project directory.
+   *
+   * @return The future of the parsed file (throws on failure).
+   */
+  QFuture<SExpression> parseFileAsync(const QString& path) const noexcept;
+
   std::unique_ptr<TransactionalDirectory> mDirectory;
   QString mFilename;  ///< the name of the *.lpp project file
 
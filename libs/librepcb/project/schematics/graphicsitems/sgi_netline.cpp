@@ -68,16 +68,18 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept {
   prepareGeometryChange();
   mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
   mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-  mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-  mBoundingRect.adjust(
-      -mNetLine.getWidth()->toPx() / 2, -mNetLine.getWidth()->toPx() / 2,
-      mNetLine.getWidth()->toPx() / 2, mNetLine.getWidth()->toPx() / 2);
+  // Note: The shape has a minimum width to make thin lines easier to grab.
+  // The bounding rect must contain the whole shape since it is used by the
+  // spatial index of the graphics scene for hit testing.
+  UnsignedLength width = qMax(mNetLine.getWidth(), UnsignedLength(1270000));
+  mBoundingRect        = QRectF(mLineF.p1(), mLineF.p2()).normalized();
+  mBoundingRect.adjust(-width->toPx() / 2, -width->toPx() / 2,
+                       width->toPx() / 2, width->toPx() / 2);
   mShape = QPainterPath();
   mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
   mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
   QPainterPathStroker ps;
   ps.setCapStyle(Qt::RoundCap);
-  UnsignedLength width = qMax(mNetLine.getWidth(), UnsignedLength(1270000));
   ps.setWidth(width->toPx());
   mShape = ps.createStroke(mShape);
   update();
@@ -78,9 +78,11 @@ void SI_Base::setSelected(bool selected) noexcept {
 void SI_Base::addToSchematic(SGI_Base* item) noexcept {
   Q_ASSERT(!mIsAddedToSchematic);
   if (item) {
+    item->setData(sGraphicsItemDataKey, QVariant::fromValue(this));
     mSchematic.getGraphicsScene().addItem(*item);
   }
   mIsAddedToSchematic = true;
+  mSchematic.notifyModified();
 }
 
 void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
@@ -89,6 +91,21 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
     mSchematic.getGraphicsScene().removeItem(*item);
   }
   mIsAddedToSchematic = false;
+  mSchematic.notifyModified();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+SI_Base* SI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  for (const QGraphicsItem* i = &item; i; i = i->parentItem()) {
+    if (SI_Base* schematicItem =
+            qvariant_cast<SI_Base*>(i->data(sGraphicsItemDataKey))) {
+      return schematicItem;
+    }
+  }
+  return nullptr;
 }
 
 /*******************************************************************************
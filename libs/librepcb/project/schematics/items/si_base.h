@@ -91,6 +91,19 @@ public:
   // Operator Overloadings
   SI_Base& operator=(const SI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the schematic item to which a graphics item belongs
+   *
+   * @param item    A graphics item of the schematic's graphics scene, or one
+   *                of its child items.
+   *
+   * @return The schematic item which added the graphics item to the
+   *         schematic, or nullptr if there is no such schematic item.
+   */
+  static SI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToSchematic(SGI_Base* item) noexcept;
@@ -100,6 +113,9 @@ protected:
   Schematic& mSchematic;
 
 private:
+  /// Key of the graphics item data which points to the schematic item
+  static const int sGraphicsItemDataKey = 0;
+
   // General Attributes
   bool mIsAddedToSchematic;
   bool mIsSelected;
@@ -94,6 +94,7 @@ void SI_NetLabel::setPosition(const Point& position) noexcept {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateAnchor();
+    mSchematic.notifyModified();
   }
 }
 
@@ -103,6 +104,7 @@ void SI_NetLabel::setRotation(const Angle& rotation) noexcept {
     mGraphicsItem->setRotation(-mRotation.toDeg());
     mGraphicsItem->updateCacheAndRepaint();
     updateAnchor();
+    mSchematic.notifyModified();
   }
 }
 
@@ -116,6 +116,7 @@ void SI_NetLine::setWidth(const UnsignedLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
     mGraphicsItem->updateCacheAndRepaint();
+    mSchematic.notifyModified();
   }
 }
 
@@ -24,6 +24,7 @@
 
 #include "../../circuit/netsignal.h"
 #include "../../erc/ercmsg.h"
+#include "../schematic.h"
 #include "si_netsegment.h"
 
 #include <QtCore>
@@ -97,6 +98,7 @@ void SI_NetPoint::setPosition(const Point& position) noexcept {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     foreach (SI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
+    mSchematic.notifyModified();
   }
 }
 
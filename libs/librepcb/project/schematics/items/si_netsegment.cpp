@@ -261,6 +261,7 @@ void SI_NetSegment::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mSchematic.notifyModified();
   }
 }
 
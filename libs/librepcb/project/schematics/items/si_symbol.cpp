@@ -158,6 +158,7 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept {
     mGraphicsItem->setPos(newPos.toPxQPointF());
     mGraphicsItem->updateCacheAndRepaint();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
+    mSchematic.notifyModified();
   }
 }
 
@@ -167,6 +168,7 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept {
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
+    mSchematic.notifyModified();
   }
 }
 
@@ -176,6 +178,7 @@ void SI_Symbol::setMirrored(bool newMirrored) noexcept {
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
+    mSchematic.notifyModified();
   }
 }
 
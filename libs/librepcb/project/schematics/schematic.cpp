@@ -53,12 +53,14 @@ namespace project {
 
 Schematic::Schematic(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
-                     bool create, const QString& newName)
+                     const SExpression& root, bool create,
+                     const QString& newName)
   : QObject(&project),
     AttributeProvider(),
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mIsModified(true),
     mUuid(Uuid::createRandom()),
     mName("New Page") {
   try {
@@ -72,9 +74,6 @@ Schematic::Schematic(Project&                                project,
       // load default grid properties
       mGridProperties.reset(new GridProperties());
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
-
       // the schematic seems to be ready to open, so we will create all needed
       // objects
 
@@ -85,7 +84,7 @@ Schematic::Schematic(Project&                                project,
       mGridProperties.reset(new GridProperties(root.getChildByPath("grid")));
 
       // Load all symbols
-      foreach (const SExpression& node, root.getChildren("symbol")) {
+      root.forEachChild("symbol", [this](const SExpression& node) {
         SI_Symbol* symbol = new SI_Symbol(*this, node);
         if (getSymbolByUuid(symbol->getUuid())) {
           throw RuntimeError(
@@ -94,10 +93,10 @@ Schematic::Schematic(Project&                                project,
                   .arg(symbol->getUuid().toStr()));
         }
         mSymbols.append(symbol);
-      }
+      });
 
       // Load all netsegments
-      foreach (const SExpression& node, root.getChildren("netsegment")) {
+      root.forEachChild("netsegment", [this](const SExpression& node) {
         SI_NetSegment* netsegment = new SI_NetSegment(*this, node);
         if (getNetSegmentByUuid(netsegment->getUuid())) {
           throw RuntimeError(
@@ -106,7 +105,7 @@ Schematic::Schematic(Project&                                project,
                   .arg(netsegment->getUuid().toStr()));
         }
         mNetSegments.append(netsegment);
-      }
+      });
     }
 
     // emit the "attributesChanged" signal when the project has emited it
@@ -150,13 +149,15 @@ bool Schematic::isEmpty() const noexcept {
 }
 
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QPointF         scenePosPx = pos.toPxQPointF();
+  QList<SI_Base*> candidates = getItemCandidatesAtScenePos(pos);
   QList<SI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
 
   // visible netpoints
-  const QList<SI_NetPoint*> netpoints(getNetPointsAtScenePos(pos));
+  const QList<SI_NetPoint*> netpoints =
+      filterNetPointsAtScenePos(candidates, pos);
   foreach (SI_NetPoint* netpoint, netpoints) {
     if (netpoint->isVisibleJunction()) {
       list.append(netpoint);
@@ -169,15 +170,15 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // netlines
-  foreach (SI_NetLine* netline, getNetLinesAtScenePos(pos)) {
+  foreach (SI_NetLine* netline, filterNetLinesAtScenePos(candidates, pos)) {
     list.append(netline);
   }
   // netlabels
-  foreach (SI_NetLabel* netlabel, getNetLabelsAtScenePos(pos)) {
+  foreach (SI_NetLabel* netlabel, filterNetLabelsAtScenePos(candidates, pos)) {
     list.append(netlabel);
   }
   // symbols & pins
-  foreach (SI_Symbol* symbol, mSymbols) {
+  foreach (SI_Symbol* symbol, getSymbolsOfItems(candidates)) {
     foreach (SI_SymbolPin* pin, symbol->getPins()) {
       if (pin->getGrabAreaScenePx().contains(scenePosPx)) list.append(pin);
     }
@@ -188,35 +189,24 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
 
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetPoint*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetPointsAtScenePos(pos, list);
-  }
-  return list;
+  return filterNetPointsAtScenePos(getItemCandidatesAtScenePos(pos), pos);
 }
 
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetLine*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLinesAtScenePos(pos, list);
-  }
-  return list;
+  return filterNetLinesAtScenePos(getItemCandidatesAtScenePos(pos), pos);
 }
 
 QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetLabel*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLabelsAtScenePos(pos, list);
-  }
-  return list;
+  return filterNetLabelsAtScenePos(getItemCandidatesAtScenePos(pos), pos);
 }
 
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_SymbolPin*> list;
-  foreach (SI_Symbol* symbol, mSymbols) {
+  foreach (SI_Symbol* symbol,
+           getSymbolsOfItems(getItemCandidatesAtScenePos(pos))) {
     foreach (SI_SymbolPin* pin, symbol->getPins()) {
       if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
         list.append(pin);
@@ -231,10 +221,12 @@ QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
 
 void Schematic::setGridProperties(const GridProperties& grid) noexcept {
   *mGridProperties = grid;
+  notifyModified();
 }
 
 void Schematic::setName(const ElementName& name) noexcept {
   mName = name;
+  notifyModified();
   emit mProject.attributesChanged();
 }
 
@@ -331,7 +323,9 @@ void Schematic::addToProject() {
     sgl.add([segment]() { segment->removeFromSchematic(); });
   }
 
+  // The schematic directory might have been removed by a save in the meantime.
   mIsAddedToProject = true;
+  mIsModified       = true;
   updateIcon();
   sgl.dismiss();
 }
@@ -357,10 +351,14 @@ void Schematic::removeFromProject() {
 
 void Schematic::save() {
   if (mIsAddedToProject) {
-    // save schematic file
-    SExpression doc(serializeToDomElement("librepcb_schematic"));  // can throw
-    mDirectory->write(getFilePath().getFilename(),
-                      doc.toByteArray());  // can throw
+    // save schematic file, but only if it was modified since the last save
+    if (mIsModified) {
+      SExpression doc(
+          serializeToDomElement("librepcb_schematic"));  // can throw
+      mDirectory->write(getFilePath().getFilename(),
+                        doc.toByteArray());  // can throw
+      mIsModified = false;
+    }
   } else {
     mDirectory->removeDirRecursively();  // can throw
   }
@@ -439,6 +437,81 @@ void Schematic::updateIcon() noexcept {
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
 
+QList<SI_Base*> Schematic::getItemCandidatesAtScenePos(
+    const Point& pos) const noexcept {
+  // The graphics scene maintains a spatial index (BSP tree) of all graphics
+  // items, so use it to determine the items whose bounding rect contains the
+  // position instead of iterating over all schematic items. Callers still
+  // need to check the exact grab area.
+  QList<SI_Base*> items;
+  foreach (const QGraphicsItem* graphicsItem,
+           mGraphicsScene->items(pos.toPxQPointF(),
+                                 Qt::IntersectsItemBoundingRect,
+                                 Qt::DescendingOrder)) {
+    SI_Base* item = SI_Base::fromGraphicsItem(*graphicsItem);
+    if (item && (&item->getSchematic() == this) && (!items.contains(item))) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
+QList<SI_NetPoint*> Schematic::filterNetPointsAtScenePos(
+    const QList<SI_Base*>& items, const Point& pos) const noexcept {
+  QList<SI_NetPoint*> list;
+  foreach (SI_Base* item, items) {
+    if (item->getType() != SI_Base::Type_t::NetPoint) continue;
+    SI_NetPoint* netpoint = static_cast<SI_NetPoint*>(item);
+    if (netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(netpoint);
+    }
+  }
+  return list;
+}
+
+QList<SI_NetLine*> Schematic::filterNetLinesAtScenePos(
+    const QList<SI_Base*>& items, const Point& pos) const noexcept {
+  QList<SI_NetLine*> list;
+  foreach (SI_Base* item, items) {
+    if (item->getType() != SI_Base::Type_t::NetLine) continue;
+    SI_NetLine* netline = static_cast<SI_NetLine*>(item);
+    if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(netline);
+    }
+  }
+  return list;
+}
+
+QList<SI_NetLabel*> Schematic::filterNetLabelsAtScenePos(
+    const QList<SI_Base*>& items, const Point& pos) const noexcept {
+  QList<SI_NetLabel*> list;
+  foreach (SI_Base* item, items) {
+    if (item->getType() != SI_Base::Type_t::NetLabel) continue;
+    SI_NetLabel* netlabel = static_cast<SI_NetLabel*>(item);
+    if (netlabel->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(netlabel);
+    }
+  }
+  return list;
+}
+
+QList<SI_Symbol*> Schematic::getSymbolsOfItems(
+    const QList<SI_Base*>& items) const noexcept {
+  QList<SI_Symbol*> symbols;  // in stacking order, top most first
+  foreach (SI_Base* item, items) {
+    SI_Symbol* symbol = nullptr;
+    if (item->getType() == SI_Base::Type_t::Symbol) {
+      symbol = static_cast<SI_Symbol*>(item);
+    } else if (item->getType() == SI_Base::Type_t::SymbolPin) {
+      symbol = &static_cast<SI_SymbolPin*>(item)->getSymbol();
+    }
+    if (symbol && (!symbols.contains(symbol))) {
+      symbols.append(symbol);
+    }
+  }
+  return symbols;
+}
+
 void Schematic::serialize(SExpression& root) const {
   root.appendChild(mUuid);
   root.appendChild("name", mName, true);
@@ -457,7 +530,8 @@ void Schematic::serialize(SExpression& root) const {
 Schematic* Schematic::create(Project&                                project,
                              std::unique_ptr<TransactionalDirectory> directory,
                              const ElementName&                      name) {
-  return new Schematic(project, std::move(directory), true, *name);
+  return new Schematic(project, std::move(directory), SExpression(), true,
+                       *name);
 }
 
 /*******************************************************************************
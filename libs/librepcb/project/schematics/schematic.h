@@ -112,8 +112,9 @@ public:
   // Constructors / Destructor
   Schematic()                       = delete;
   Schematic(const Schematic& other) = delete;
-  Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Schematic(project, std::move(directory), false, QString()) {}
+  Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+            const SExpression& root)
+    : Schematic(project, std::move(directory), root, false, QString()) {}
   ~Schematic() noexcept;
 
   // Getters: General
@@ -152,6 +153,14 @@ public:
   void           addNetSegment(SI_NetSegment& netsegment);
   void           removeNetSegment(SI_NetSegment& netsegment);
 
+  /**
+   * @brief Notify that the content of the schematic file was modified
+   *
+   * This is called by the schematic items on every modification. #save() only
+   * serializes the schematic file if it was modified since the last save.
+   */
+  void notifyModified() noexcept { mIsModified = true; }
+
   // General Methods
   void addToProject();
   void removeFromProject();
@@ -191,8 +200,19 @@ signals:
 
 private:
   Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-            bool create, const QString& newName);
+            const SExpression& root, bool create, const QString& newName);
   void updateIcon() noexcept;
+  QList<SI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
+  QList<SI_NetPoint*> filterNetPointsAtScenePos(const QList<SI_Base*>& items,
+                                                const Point& pos) const
+      noexcept;
+  QList<SI_NetLine*> filterNetLinesAtScenePos(const QList<SI_Base*>& items,
+                                              const Point& pos) const noexcept;
+  QList<SI_NetLabel*> filterNetLabelsAtScenePos(const QList<SI_Base*>& items,
+                                                const Point& pos) const
+      noexcept;
+  QList<SI_Symbol*> getSymbolsOfItems(const QList<SI_Base*>& items) const
+      noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -201,6 +221,7 @@ private:
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool                                    mIsAddedToProject;
+  bool                                    mIsModified;  ///< see #save()
 
   QScopedPointer<GraphicsScene>  mGraphicsScene;
   QScopedPointer<GridProperties> mGridProperties;
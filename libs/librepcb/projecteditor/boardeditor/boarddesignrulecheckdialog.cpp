@@ -118,25 +118,29 @@ void BoardDesignRuleCheckDialog::btnRunDrcClicked() noexcept {
     mUi->lstMessages->clear();
     mUi->lstProgress->clear();
 
-    BoardDesignRuleCheck drc(mBoard, getOptions());
-    connect(&drc, &BoardDesignRuleCheck::progressPercent, mUi->prgProgress,
-            &QProgressBar::setValue);
-    connect(&drc, &BoardDesignRuleCheck::progressStatus, mUi->lstProgress,
+    std::unique_ptr<BoardDesignRuleCheck> drc(
+        new BoardDesignRuleCheck(mBoard, getOptions()));
+    connect(drc.get(), &BoardDesignRuleCheck::progressPercent,
+            mUi->prgProgress, &QProgressBar::setValue);
+    connect(drc.get(), &BoardDesignRuleCheck::progressStatus,
+            mUi->lstProgress,
             static_cast<void (QListWidget::*)(const QString&)>(
                 &QListWidget::addItem));
-    connect(&drc, &BoardDesignRuleCheck::progressMessage, mUi->lstMessages,
+    connect(drc.get(), &BoardDesignRuleCheck::progressMessage,
+            mUi->lstMessages,
             static_cast<void (QListWidget::*)(const QString&)>(
                 &QListWidget::addItem));
 
     // Use the progressStatus() signal (because it is not emitted too often
     // which would lead to flickering) to update both list widgets.
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstProgress,
+    connect(drc.get(), SIGNAL(progressStatus(QString)), mUi->lstProgress,
             SLOT(repaint()));
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstMessages,
+    connect(drc.get(), SIGNAL(progressStatus(QString)), mUi->lstMessages,
             SLOT(repaint()));
 
-    drc.execute();  // can throw
-    mMessages = drc.getMessages();
+    drc->execute();  // can throw
+    mMessages = drc->getMessages();
+    mDrc      = std::move(drc);
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
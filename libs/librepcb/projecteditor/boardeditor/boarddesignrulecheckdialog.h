@@ -29,6 +29,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -71,6 +73,18 @@ public:
     return mMessages;
   }
 
+  /**
+   * @brief Take the DRC object of the last successful run
+   *
+   * It can be used to keep the messages up to date with
+   * ::librepcb::project::BoardDesignRuleCheck::startIncremental().
+   *
+   * @return The DRC object, or nullptr if the DRC was not run successfully
+   */
+  std::unique_ptr<BoardDesignRuleCheck> takeDesignRuleCheck() noexcept {
+    return std::move(mDrc);
+  }
+
 private:  // GUI Event Handlers
   void btnRunDrcClicked() noexcept;
 
@@ -78,6 +92,7 @@ private:
   Board&                                           mBoard;
   QScopedPointer<Ui::BoardDesignRuleCheckDialog>   mUi;
   tl::optional<QList<BoardDesignRuleCheckMessage>> mMessages;
+  std::unique_ptr<BoardDesignRuleCheck>            mDrc;
 };
 
 /*******************************************************************************
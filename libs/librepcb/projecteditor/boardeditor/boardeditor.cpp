@@ -130,6 +130,17 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   tabifyDockWidget(mErcMsgDock, mDrcMessagesDock.data());
   mUnplacedComponentsDock->raise();
 
+  // Re-check the modified areas of the board after the last DRC run, but only
+  // when there were no more modifications for a while.
+  mIncrementalDrcTimer.setSingleShot(true);
+  mIncrementalDrcTimer.setInterval(500);
+  connect(&mIncrementalDrcTimer, &QTimer::timeout, this,
+          &BoardEditor::runIncrementalDrc);
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, this,
+          &BoardEditor::scheduleIncrementalDrc);
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::commandGroupEnded, this,
+          &BoardEditor::scheduleIncrementalDrc);
+
   // add graphics view as central widget
   mGraphicsView = new GraphicsView(nullptr, this);
   mGraphicsView->setUseOpenGl(
@@ -301,6 +312,8 @@ BoardEditor::~BoardEditor() {
   mUnplacedComponentsDock = nullptr;
   delete mErcMsgDock;
   mErcMsgDock = nullptr;
+  mIncrementalDrcTimer.stop();
+  mIncrementalDrc.reset();
   mDrcMessagesDock.reset();
   delete mGraphicsView;
   mGraphicsView = nullptr;
@@ -321,9 +334,17 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       // reasons)
       disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
                  mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+      disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
+                 mActiveBoard.data(), &Board::schedulePlanesRebuild);
+      disconnect(mActiveBoard.data(), &Board::planesRebuilt, this,
+                 &BoardEditor::scheduleIncrementalDrc);
+      disconnect(mActiveBoard.data(), &Board::airWiresRebuilt, this,
+                 &BoardEditor::scheduleIncrementalDrc);
       // save current view scene rect
       mActiveBoard->saveViewSceneRect(mGraphicsView->getVisibleSceneRect());
     }
+    mIncrementalDrcTimer.stop();
+    mIncrementalDrc.reset();  // belongs to the previously active board
     mActiveBoard = newBoard;
     if (mActiveBoard) {
       // show scene, restore view scene rect, set grid properties
@@ -336,6 +357,14 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       mActiveBoard->triggerAirWiresRebuild();
       connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
               mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+      // refill planes in background after every project modification
+      connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
+              mActiveBoard.data(), &Board::schedulePlanesRebuild);
+      // the background jobs modify the board too, so check it again afterwards
+      connect(mActiveBoard.data(), &Board::planesRebuilt, this,
+              &BoardEditor::scheduleIncrementalDrc);
+      connect(mActiveBoard.data(), &Board::airWiresRebuilt, this,
+              &BoardEditor::scheduleIncrementalDrc);
     } else {
       mGraphicsView->setScene(nullptr);
     }
@@ -723,6 +752,14 @@ void BoardEditor::on_actionDesignRuleCheck_triggered() {
   dialog.exec();
   mDrcOptions = dialog.getOptions();
   if (dialog.getMessages()) {
+    mIncrementalDrc = dialog.takeDesignRuleCheck();
+    connect(mIncrementalDrc.get(), &BoardDesignRuleCheck::finished, this,
+            &BoardEditor::incrementalDrcFinished);
+    connect(mIncrementalDrc.get(), &BoardDesignRuleCheck::failed,
+            [](const QString& msg) {
+              // the next run will check the whole board again
+              qWarning() << "Incremental DRC failed:" << msg;
+            });
     clearDrcMarker();
     mDrcMessages.insert(board->getUuid(), *dialog.getMessages());
     mDrcMessagesDock->setMessages(*dialog.getMessages());
@@ -846,6 +883,45 @@ void BoardEditor::clearDrcMarker() noexcept {
   mGraphicsView->setSceneRectMarker(QRectF());
 }
 
+void BoardEditor::scheduleIncrementalDrc() noexcept {
+  if (mIncrementalDrc) {
+    mIncrementalDrcTimer.start();
+  }
+}
+
+void BoardEditor::runIncrementalDrc() noexcept {
+  Board* board = getActiveBoard();
+  if ((!mIncrementalDrc) || (!board)) {
+    return;
+  }
+  if (mProjectEditor.getUndoStack().isCommandGroupActive()) {
+    return;  // will be triggered again when the command group is finished
+  }
+  if (mIncrementalDrc->isRunning()) {
+    // try again when the running check is finished
+    mIncrementalDrcTimer.start();
+    return;
+  }
+
+  try {
+    // see incrementalDrcFinished()
+    mIncrementalDrc->startIncremental();  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Incremental DRC failed:" << e.getMsg();
+    mIncrementalDrc.reset();  // messages stay as they are until the next run
+  }
+}
+
+void BoardEditor::incrementalDrcFinished() noexcept {
+  Board* board = getActiveBoard();
+  if ((!mIncrementalDrc) || (!board)) {
+    return;
+  }
+  clearDrcMarker();
+  mDrcMessages.insert(board->getUuid(), mIncrementalDrc->getMessages());
+  mDrcMessagesDock->setMessages(mIncrementalDrc->getMessages());
+}
+
 QStringList BoardEditor::getSearchToolBarCompleterList() noexcept {
   QStringList list;
   if (Board* board = getActiveBoard()) {
@@ -31,6 +31,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -132,6 +134,9 @@ private:
   void        highlightDrcMessage(const BoardDesignRuleCheckMessage& msg,
                                   bool                               zoomTo) noexcept;
   void        clearDrcMarker() noexcept;
+  void        scheduleIncrementalDrc() noexcept;
+  void        runIncrementalDrc() noexcept;
+  void        incrementalDrcFinished() noexcept;
   QStringList getSearchToolBarCompleterList() noexcept;
   void        goToDevice(const QString& name) noexcept;
 
@@ -149,6 +154,10 @@ private:
                                     mDrcMessages;  ///< Key: Board UUID
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
 
+  // Incremental DRC, keeping the DRC messages of the active board up to date
+  std::unique_ptr<BoardDesignRuleCheck> mIncrementalDrc;
+  QTimer                                mIncrementalDrcTimer;
+
   // Misc
   QPointer<Board> mActiveBoard;
   QList<QAction*> mBoardListActions;
@@ -168,6 +168,7 @@ void FabricationOutputDialog::on_btnGenerate_clicked() {
     s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
     if (s != mBoard.getFabricationOutputSettings()) {
       mBoard.getFabricationOutputSettings() = s;  // TODO: use undo command
+      mBoard.notifyModified();
     }
 
     // generate files
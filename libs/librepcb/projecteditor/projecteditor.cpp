@@ -78,6 +78,8 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
     // autosaving is enabled --> start the timer
     connect(&mAutoSaveTimer, &QTimer::timeout, this,
             &ProjectEditor::autosaveProject);
+    connect(&mAutoSaveWatcher, &QFutureWatcher<void>::finished, this,
+            &ProjectEditor::autosaveFinished);
     mAutoSaveTimer.start(1000 * intervalSecs);
   }
 }
@@ -226,11 +228,18 @@ bool ProjectEditor::autosaveProject() noexcept {
     return false;
   }
 
+  if (mAutoSaveWatcher.isRunning()) {
+    // the previous autosave is still being written, so just skip this one
+    return false;
+  }
+
   try {
+    // Only serialize the project here, the files are written to the disk in a
+    // worker thread to not block the user interface.
     qDebug() << "Autosave project...";
-    mProject.save();                                      // can throw
-    mProject.getDirectory().getFileSystem()->autosave();  // can throw
-    qDebug() << "Project successfully autosaved";
+    mProject.save();  // can throw
+    mAutoSaveWatcher.setFuture(
+        mProject.getDirectory().getFileSystem()->autosaveAsync());  // can throw
     return true;
   } catch (Exception& exc) {
     return false;
@@ -289,6 +298,15 @@ int ProjectEditor::getCountOfVisibleEditorWindows() const noexcept {
   return count;
 }
 
+void ProjectEditor::autosaveFinished() noexcept {
+  try {
+    mAutoSaveWatcher.waitForFinished();  // can throw
+    qDebug() << "Project successfully autosaved";
+  } catch (const Exception& e) {
+    qCritical() << "Failed to autosave project:" << e.getMsg();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
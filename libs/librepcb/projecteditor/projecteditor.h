@@ -171,9 +171,13 @@ public slots:
   /**
    * @brief Make a automatic backup of the project (save to temporary files)
    *
+   * The project is serialized immediately, but the files are written to the
+   * disk in a worker thread. If the previous autosave is still running, no
+   * new autosave is started.
+   *
    * @note The whole save procedere is described in @ref doc_project_save.
    *
-   * @return true on success, false on failure
+   * @return true if the autosave was started, false on failure
    */
   bool autosaveProject() noexcept;
 
@@ -212,13 +216,15 @@ signals:
   void projectEditorClosed();
 
 private:  // Methods
-  int getCountOfVisibleEditorWindows() const noexcept;
+  int  getCountOfVisibleEditorWindows() const noexcept;
+  void autosaveFinished() noexcept;
 
 private:  // Data
   workspace::Workspace& mWorkspace;
   Project&              mProject;
   QTimer mAutoSaveTimer;  ///< the timer for the periodically automatic saving
                           ///< functionality (see also @ref doc_project_save)
+  QFutureWatcher<void> mAutoSaveWatcher;  ///< watches the running autosave
   UndoStack*       mUndoStack;        ///< See @ref doc_project_undostack
   SchematicEditor* mSchematicEditor;  ///< The schematic editor (GUI)
   BoardEditor*     mBoardEditor;      ///< The board editor (GUI)
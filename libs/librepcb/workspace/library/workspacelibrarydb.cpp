@@ -806,6 +806,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -828,6 +829,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -850,6 +852,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -879,6 +882,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL "
       ")");
@@ -908,6 +912,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -937,6 +942,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
@@ -28,7 +28,9 @@
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/common/toolbox.h>
 #include <librepcb/library/elements.h>
+#include <librepcb/library/librarybaseelementmetadata.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -130,8 +132,15 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
+    // get all elements which are already in the database, to only parse the
+    // elements which were added or modified since the last scan
+    DbElements componentCategories =
+        getElementsInDb(db, "component_categories");
+    DbElements packageCategories = getElementsInDb(db, "package_categories");
+    DbElements symbols           = getElementsInDb(db, "symbols");
+    DbElements packages          = getElementsInDb(db, "packages");
+    DbElements components        = getElementsInDb(db, "components");
+    DbElements devices           = getElementsInDb(db, "devices");
 
     // scan all libraries
     int   count   = 0;
@@ -142,37 +151,45 @@ void WorkspaceLibraryScanner::scan() noexcept {
       const std::shared_ptr<Library>& lib   = libraries[fp];
       Q_ASSERT(lib);
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<ComponentCategory>(
+      count += addElementsToDb<ComponentCategory>(
           db, fs, fp, lib->searchForElements<ComponentCategory>(),
-          "component_categories", "cat_id", libId);
+          "component_categories", "cat_id", libId, componentCategories);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<PackageCategory>(
+      count += addElementsToDb<PackageCategory>(
           db, fs, fp, lib->searchForElements<PackageCategory>(),
-          "package_categories", "cat_id", libId);
+          "package_categories", "cat_id", libId, packageCategories);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Symbol>(db, fs, fp, lib->searchForElements<Symbol>(),
-                                  "symbols", "symbol_id", libId);
+      count += addElementsToDb<Symbol>(db, fs, fp,
+                                       lib->searchForElements<Symbol>(),
+                                       "symbols", "symbol_id", libId, symbols);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Package>(db, fs, fp,
-                                        lib->searchForElements<Package>(),
-                                        "packages", "package_id", libId);
+      count += addElementsToDb<Package>(
+          db, fs, fp, lib->searchForElements<Package>(), "packages",
+          "package_id", libId, packages);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Component>(db, fs, fp,
-                                          lib->searchForElements<Component>(),
-                                          "components", "component_id", libId);
+      count += addElementsToDb<Component>(
+          db, fs, fp, lib->searchForElements<Component>(), "components",
+          "component_id", libId, components);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Device>(db, fs, fp, lib->searchForElements<Device>(),
-                                  "devices", "device_id", libId);
+      count += addElementsToDb<Device>(db, fs, fp,
+                                       lib->searchForElements<Device>(),
+                                       "devices", "device_id", libId, devices);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
+    // remove all elements which no longer exist
+    removeElementsFromDb(db, "component_categories", componentCategories);
+    removeElementsFromDb(db, "package_categories", packageCategories);
+    removeElementsFromDb(db, "symbols", symbols);
+    removeElementsFromDb(db, "packages", packages);
+    removeElementsFromDb(db, "components", components);
+    removeElementsFromDb(db, "devices", devices);
+
     // commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
       transactionGuard.commit();  // can throw
@@ -303,122 +320,151 @@ QHash<QString, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
-
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
-
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
-
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
-
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
+WorkspaceLibraryScanner::DbElements WorkspaceLibraryScanner::getElementsInDb(
+    SQLiteDatabase& db, const QString& table) {
+  DbElements elements;
+  QSqlQuery  query =
+      db.prepareQuery("SELECT id, lib_id, filepath, fingerprint FROM " % table);
+  db.exec(query);
+  while (query.next()) {
+    DbElement element;
+    element.id          = query.value(0).toInt();
+    element.libId       = query.value(1).toInt();
+    element.fingerprint = query.value(3).toString();
+    elements.insert(query.value(2).toString(), element);
+  }
+  return elements;
+}
+
+bool WorkspaceLibraryScanner::isElementUpToDate(
+    SQLiteDatabase& db, const QString& table, const QString& path,
+    const QString& fingerprint, int libId, DbElements& dbElements) {
+  auto it = dbElements.find(path);
+  if (it == dbElements.end()) {
+    return false;  // new element
+  }
+  bool upToDate =
+      (it.value().libId == libId) && (it.value().fingerprint == fingerprint);
+  if (!upToDate) {
+    // remove the outdated element, it will be added again by the caller
+    removeElementFromDb(db, table, it.value().id);
+  }
+  dbElements.erase(it);
+  return upToDate;
+}
+
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    SQLiteDatabase& db, const QString& table, const DbElements& dbElements) {
+  foreach (const DbElement& element, dbElements) {
+    removeElementFromDb(db, table, element.id);
+  }
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(SQLiteDatabase& db,
+                                                  const QString&  table,
+                                                  int             id) {
+  // Note: Translations and categories are removed by "ON DELETE CASCADE".
+  QSqlQuery query =
+      db.prepareCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+  query.bindValue(":id", id);
+  db.exec(query);
+}
+
+QString WorkspaceLibraryScanner::getElementFingerprint(
+    const TransactionalFileSystem& fs, const QString& path) noexcept {
+  // Only the size and modification time of the files are taken into account,
+  // which is much faster than reading their content.
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  foreach (const QString& filename, Toolbox::sorted(fs.getFiles(path))) {
+    QFileInfo info(fs.getAbsPath(path % "/" % filename).toStr());
+    hash.addData(filename.toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+  }
+  return QString::fromLatin1(hash.result().toHex());
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(
+int WorkspaceLibraryScanner::addElementsToDb(
     SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
     const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
+    const QString& idColumn, int libId, DbElements& dbElements) {
+  // determine which elements need to be parsed, unmodified ones are skipped
+  int         count = 0;
+  QStringList paths;
+  QStringList fingerprints;
   foreach (const QString& dirpath, dirs) {
+    if (mAbort || (mSemaphore.available() > 0)) return count;
+    QString fullPath    = libPath % "/" % dirpath;
+    QString fingerprint = getElementFingerprint(*fs, fullPath);
+    if (isElementUpToDate(db, table, fullPath, fingerprint, libId,
+                          dbElements)) {  // can throw
+      count++;
+    } else {
+      paths.append(fullPath);
+      fingerprints.append(fingerprint);
+    }
+  }
+
+  // Parse the elements in worker threads while this thread writes the already
+  // parsed elements into the database. The number of pending jobs is limited
+  // to keep the memory usage low and to be able to abort the scan quickly.
+  const int maxJobs = qMax(QThread::idealThreadCount(), 1) * 4;
+  QQueue<QFuture<std::shared_ptr<const LibraryBaseElementMetadata>>> jobs;
+  int nextJob = 0;
+  for (int i = 0; i < paths.count(); ++i) {
     if (mAbort || (mSemaphore.available() > 0)) break;
-    QString fullPath = libPath % "/" % dirpath;
+    while ((nextJob < paths.count()) && (jobs.count() < maxJobs)) {
+      jobs.enqueue(parseElementAsync<ElementType>(fs, paths.at(nextJob++)));
+    }
     try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath", fullPath);
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
+      std::shared_ptr<const LibraryBaseElementMetadata> element =
+          jobs.dequeue().result();  // can throw
+      addElementToDb<ElementType>(db, table, idColumn, libId, paths.at(i),
+                                  fingerprints.at(i), *element);  // can throw
       count++;
     } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << fullPath;
+      qWarning() << "Failed to open library element:" << paths.at(i);
     }
   }
-  return count;
-}
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(
-    SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
-    const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
-  foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    QString fullPath = libPath % "/" % dirpath;
+  // wait for the remaining jobs of an aborted scan as they refer to this thread
+  while (!jobs.isEmpty()) {
     try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      addElementToDb(db, table, idColumn, libId, fullPath, element);
-      count++;
+      jobs.dequeue().waitForFinished();  // can throw
     } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << fullPath;
     }
   }
   return count;
 }
 
 template <typename ElementType>
-void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
-                                             const QString&  table,
-                                             const QString& idColumn, int libId,
-                                             const QString&     path,
-                                             const ElementType& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " (lib_id, filepath, uuid, version) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version)");
+QFuture<std::shared_ptr<const LibraryBaseElementMetadata>>
+    WorkspaceLibraryScanner::parseElementAsync(
+        std::shared_ptr<TransactionalFileSystem> fs,
+        const QString&                           path) noexcept {
+  // Note: Only the metadata of the element is read since loading the whole
+  // element (e.g. all footprints of a package) is not needed for the index.
+  return QtConcurrent::run([fs, path]() {
+    TransactionalDirectory dir(fs, path);
+    return std::make_shared<const LibraryBaseElementMetadata>(
+        dir, true, ElementType::getShortElementName(),
+        ElementType::getLongElementName());  // can throw
+  });
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::addElementToDb(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    int libId, const QString& path, const QString& fingerprint,
+    const LibraryBaseElementMetadata& element) {
+  QSqlQuery query = db.prepareCachedQuery(
+      "INSERT INTO " % table %
+      " (lib_id, filepath, fingerprint, uuid, version) VALUES "
+      "(:lib_id, :filepath, :fingerprint, :uuid, :version)");
   query.bindValue(":lib_id", libId);
   query.bindValue(":filepath", path);
+  query.bindValue(":fingerprint", fingerprint);
   query.bindValue(":uuid", element.getUuid().toStr());
   query.bindValue(":version", element.getVersion().toStr());
   int id = db.insert(query);
@@ -427,34 +473,73 @@ void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
                            element.getCategories());
 }
 
+template <>
+void WorkspaceLibraryScanner::addElementToDb<ComponentCategory>(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    int libId, const QString& path, const QString& fingerprint,
+    const LibraryBaseElementMetadata& element) {
+  addCategoryToDb(db, table, idColumn, libId, path, fingerprint, element);
+}
+
+template <>
+void WorkspaceLibraryScanner::addElementToDb<PackageCategory>(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    int libId, const QString& path, const QString& fingerprint,
+    const LibraryBaseElementMetadata& element) {
+  addCategoryToDb(db, table, idColumn, libId, path, fingerprint, element);
+}
+
 template <>
 void WorkspaceLibraryScanner::addElementToDb<Device>(
     SQLiteDatabase& db, const QString& table, const QString& idColumn,
-    int libId, const QString& path, const Device& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " "
-                                    "(lib_id, filepath, uuid, version, "
-                                    "component_uuid, package_uuid) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version, "
-                                    ":component_uuid, :package_uuid)");
+    int libId, const QString& path, const QString& fingerprint,
+    const LibraryBaseElementMetadata& element) {
+  QSqlQuery query = db.prepareCachedQuery(
+      "INSERT INTO " % table %
+      " (lib_id, filepath, fingerprint, uuid, version, component_uuid, "
+      "package_uuid) VALUES "
+      "(:lib_id, :filepath, :fingerprint, :uuid, :version, :component_uuid, "
+      ":package_uuid)");
   query.bindValue(":lib_id", libId);
   query.bindValue(":filepath", path);
+  query.bindValue(":fingerprint", fingerprint);
   query.bindValue(":uuid", element.getUuid().toStr());
   query.bindValue(":version", element.getVersion().toStr());
-  query.bindValue(":component_uuid", element.getComponentUuid().toStr());
-  query.bindValue(":package_uuid", element.getPackageUuid().toStr());
+  query.bindValue(":component_uuid",
+                  element.getValueByPath<Uuid>("component").toStr());
+  query.bindValue(":package_uuid",
+                  element.getValueByPath<Uuid>("package").toStr());
   int id = db.insert(query);
   addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
   addElementCategoriesToDb(db, table % "_cat", idColumn, id,
                            element.getCategories());
 }
 
-template <typename ElementType>
+void WorkspaceLibraryScanner::addCategoryToDb(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    int libId, const QString& path, const QString& fingerprint,
+    const LibraryBaseElementMetadata& element) {
+  QSqlQuery query = db.prepareCachedQuery(
+      "INSERT INTO " % table %
+      " (lib_id, filepath, fingerprint, uuid, version, parent_uuid) VALUES "
+      "(:lib_id, :filepath, :fingerprint, :uuid, :version, :parent_uuid)");
+  query.bindValue(":lib_id", libId);
+  query.bindValue(":filepath", path);
+  query.bindValue(":fingerprint", fingerprint);
+  query.bindValue(":uuid", element.getUuid().toStr());
+  query.bindValue(":version", element.getVersion().toStr());
+  query.bindValue(":parent_uuid", element.getParentUuid()
+                                      ? element.getParentUuid()->toStr()
+                                      : QVariant(QVariant::String));
+  int id = db.insert(query);
+  addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
+}
+
 void WorkspaceLibraryScanner::addElementTranslationsToDb(
     SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
-    const ElementType& element) {
+    const LibraryBaseElementMetadata& element) {
   foreach (const QString& locale, element.getAllAvailableLocales()) {
-    QSqlQuery query = db.prepareQuery(
+    QSqlQuery query = db.prepareCachedQuery(
         "INSERT INTO " % table % " (" % idColumn %
         ", locale, name, description, keywords) VALUES "
         "(:element_id, :locale, :name, :description, :keywords)");
@@ -475,9 +560,10 @@ void WorkspaceLibraryScanner::addElementCategoriesToDb(
     SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
     const QSet<Uuid>& categories) {
   foreach (const Uuid& categoryUuid, categories) {
-    QSqlQuery query = db.prepareQuery("INSERT INTO " % table % " (" % idColumn %
-                                      ", category_uuid) VALUES "
-                                      "(:element_id, :category_uuid)");
+    QSqlQuery query = db.prepareCachedQuery(
+        "INSERT INTO " % table % " (" % idColumn %
+        ", category_uuid) VALUES "
+        "(:element_id, :category_uuid)");
     query.bindValue(":element_id", id);
     query.bindValue(":category_uuid", categoryUuid.toStr());
     db.insert(query);
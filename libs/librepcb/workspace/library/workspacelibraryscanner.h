@@ -41,6 +41,7 @@ class TransactionalFileSystem;
 
 namespace library {
 class Library;
+class LibraryBaseElementMetadata;
 }
 
 namespace workspace {
@@ -82,35 +83,55 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  /// An element which is already in the database
+  struct DbElement {
+    int     id;
+    int     libId;
+    QString fingerprint;  ///< See #getElementFingerprint()
+  };
+  typedef QHash<QString, DbElement> DbElements;  ///< Key: File path
+
 private:  // Methods
   void                run() noexcept override;
   void                scan() noexcept;
   QHash<QString, int> updateLibraries(
       SQLiteDatabase&                                          db,
       const QHash<QString, std::shared_ptr<library::Library>>& libs);
-  void clearAllTables(SQLiteDatabase& db);
+  DbElements getElementsInDb(SQLiteDatabase& db, const QString& table);
+  bool       isElementUpToDate(SQLiteDatabase& db, const QString& table,
+                               const QString& path, const QString& fingerprint,
+                               int libId, DbElements& dbElements);
+  void       removeElementsFromDb(SQLiteDatabase& db, const QString& table,
+                                  const DbElements& dbElements);
+  void removeElementFromDb(SQLiteDatabase& db, const QString& table, int id);
+  static QString getElementFingerprint(const TransactionalFileSystem& fs,
+                                       const QString& path) noexcept;
   void getLibrariesOfDirectory(
       std::shared_ptr<TransactionalFileSystem> fs, const QString& root,
       QHash<QString, std::shared_ptr<library::Library>>& libs) noexcept;
   template <typename ElementType>
-  int addCategoriesToDb(SQLiteDatabase&                          db,
-                        std::shared_ptr<TransactionalFileSystem> fs,
-                        const QString& libPath, const QStringList& dirs,
-                        const QString& table, const QString& idColumn,
-                        int libId);
-  template <typename ElementType>
   int addElementsToDb(SQLiteDatabase&                          db,
                       std::shared_ptr<TransactionalFileSystem> fs,
                       const QString& libPath, const QStringList& dirs,
-                      const QString& table, const QString& idColumn, int libId);
+                      const QString& table, const QString& idColumn, int libId,
+                      DbElements& dbElements);
+  template <typename ElementType>
+  QFuture<std::shared_ptr<const library::LibraryBaseElementMetadata>>
+      parseElementAsync(std::shared_ptr<TransactionalFileSystem> fs,
+                        const QString&                           path) noexcept;
   template <typename ElementType>
   void addElementToDb(SQLiteDatabase& db, const QString& table,
                       const QString& idColumn, int libId, const QString& path,
-                      const ElementType& element);
-  template <typename ElementType>
-  void addElementTranslationsToDb(SQLiteDatabase& db, const QString& table,
-                                  const QString& idColumn, int id,
-                                  const ElementType& element);
+                      const QString&                              fingerprint,
+                      const library::LibraryBaseElementMetadata& element);
+  void addCategoryToDb(SQLiteDatabase& db, const QString& table,
+                       const QString& idColumn, int libId, const QString& path,
+                       const QString&                              fingerprint,
+                       const library::LibraryBaseElementMetadata& element);
+  void addElementTranslationsToDb(
+      SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
+      const library::LibraryBaseElementMetadata& element);
   void addElementCategoriesToDb(SQLiteDatabase& db, const QString& table,
                                 const QString& idColumn, int id,
                                 const QSet<Uuid>& categories);
@@ -2,6 +2,8 @@
 # -*- coding: utf-8 -*-
 
 import os
+import re
+import uuid
 import fileinput
 import params
 import pytest
@@ -288,3 +290,65 @@ def test_if_export_with_invalid_settings_fails(cli, project):
     assert len(stdout) > 0
     assert stdout[-1] == 'Finished with errors!'
     assert not os.path.exists(dir)
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+])
+def test_export_with_optimized_drill_path(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+
+    # add holes in a random order to the board, with a diameter smaller than
+    # all other drills to get them drilled first (i.e. starting at the origin)
+    boardfile = cli.abspath(project.dir + '/boards/default/board.lp')
+    with open(boardfile, 'r') as f:
+        content = f.read().rstrip()
+    assert content.endswith(')')
+    for x in [5, 2, 8, 1, 9, 3, 7, 4, 6]:
+        content = content[:-1] + \
+            ' (hole {} (diameter 0.1) (position {}.0 1.0))\n)'.format(
+                uuid.uuid4(), x)
+    with open(boardfile, 'w') as f:
+        f.write(content + '\n')
+
+    dir = cli.abspath(project.output_dir + '/gerber')
+    assert not os.path.exists(dir)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-pcb-fabrication-data',
+                                   '--optimize-drill-path',
+                                   '--board=default',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 0
+    assert stdout[-1] == 'SUCCESS'
+    assert os.path.exists(dir)
+    assert len(os.listdir(dir)) == 9  # including the NPTH drills
+
+    # the holes must be drilled from left to right
+    drills = []
+    for filename in sorted(os.listdir(dir)):
+        if filename.endswith('.drl'):
+            drills += read_drills(os.path.join(dir, filename), '0.1')
+    assert drills == ['X{}.0Y1.0'.format(x) for x in range(1, 10)]
+
+
+def read_drills(filepath, diameter):
+    """
+    Get the drill positions of the given tool diameter in the order of an
+    Excellon file
+    """
+    tools = {}
+    tool = None
+    drills = []
+    with open(filepath, 'r') as f:
+        for line in f.read().splitlines():
+            match = re.match(r'^T([0-9]+)C([0-9.]+)$', line)
+            if match:
+                tools[match.group(1)] = match.group(2)
+            elif re.match(r'^T[0-9]+$', line):
+                tool = line[1:]
+            elif line.startswith('X') and tools.get(tool) == diameter:
+                drills.append(line)
+    return drills
@@ -26,6 +26,8 @@
 
 #include <QtCore>
 
+#include <iostream>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -178,6 +180,127 @@ TEST_F(AirWiresBuilderTest, testPartlyConnectedColinearPoints) {
   EXPECT_EQ(expected, airwires);
 }
 
+TEST_F(AirWiresBuilderTest, testCoincidentPoints) {
+  AirWiresBuilder builder;
+  int             id0 = builder.addPoint(Point(0, 0));
+  int             id1 = builder.addPoint(Point(0, 0));
+  /*int id2 = */ builder.addPoint(Point(0, 0));
+  /*int id3 = */ builder.addPoint(Point(100000, 0));
+  /*int id4 = */ builder.addPoint(Point(100000, 100000));
+  builder.addEdge(id0, id1);
+  AirWiresBuilder::AirWires airwires = sorted(builder.buildAirWires());
+  AirWiresBuilder::AirWires expected = {
+      {Point(0, 0), Point(0, 0)},
+      {Point(0, 0), Point(100000, 0)},
+      {Point(100000, 0), Point(100000, 100000)}};
+  EXPECT_EQ(expected, airwires);
+}
+
+TEST_F(AirWiresBuilderTest, testRebuildAfterModifications) {
+  AirWiresBuilder builder;
+  int             id0 = builder.addPoint(Point(0, 0));
+  int             id1 = builder.addPoint(Point(100000, 0));
+  int             id2 = builder.addPoint(Point(200000, 0));
+  int             id3 = builder.addPoint(Point(300000, 0));
+  builder.buildAirWires();
+
+  // add an edge (reuses the triangulation)
+  builder.addEdge(id1, id2);
+  AirWiresBuilder::AirWires airwires = sorted(builder.buildAirWires());
+  AirWiresBuilder::AirWires expected = {
+      {Point(0, 0), Point(100000, 0)}, {Point(200000, 0), Point(300000, 0)}};
+  EXPECT_EQ(expected, airwires);
+
+  // remove a point (removes its edges as well)
+  builder.removePoint(id1);
+  airwires = sorted(builder.buildAirWires());
+  expected = {{Point(0, 0), Point(200000, 0)},
+              {Point(200000, 0), Point(300000, 0)}};
+  EXPECT_EQ(expected, airwires);
+
+  // add a point and an edge
+  int id4 = builder.addPoint(Point(400000, 0));
+  builder.addEdge(id3, id4);
+  builder.addEdge(id0, id2);
+  airwires = sorted(builder.buildAirWires());
+  expected = {{Point(200000, 0), Point(300000, 0)}};
+  EXPECT_EQ(expected, airwires);
+
+  // remove an edge
+  builder.removeEdge(id2, id0);
+  airwires = sorted(builder.buildAirWires());
+  expected = {{Point(0, 0), Point(200000, 0)},
+              {Point(200000, 0), Point(300000, 0)}};
+  EXPECT_EQ(expected, airwires);
+}
+
+// Micro-benchmark with a large net like GND on a big board. Disabled by
+// default, run it with "--gtest_also_run_disabled_tests".
+TEST_F(AirWiresBuilderTest, DISABLED_benchmarkLargeNet) {
+  QVector<Point>               points;
+  QVector<std::pair<int, int>> edges;
+  for (int x = 0; x < 100; ++x) {
+    for (int y = 0; y < 100; ++y) {
+      // some pads are placed on top of each other (e.g. stacked footprints)
+      points.append(Point((x / 2) * 1270000, y * 1270000));
+    }
+  }
+  for (int i = 1; i < points.count(); i += 3) {
+    edges.append(std::make_pair(i - 1, i));
+  }
+
+  AirWiresBuilder builder;
+  QVector<int>    ids;
+  foreach (const Point& point, points) { ids.append(builder.addPoint(point)); }
+  for (const auto& edge : edges) {
+    builder.addEdge(ids.at(edge.first), ids.at(edge.second));
+  }
+  QElapsedTimer timer;
+  timer.start();
+  AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+  qint64 initialTime = timer.nsecsElapsed();
+  EXPECT_GT(airwires.count(), 0);
+
+  // after connecting more points, the triangulation is reused
+  for (int i = 2; i < points.count(); i += 3) {
+    edges.append(std::make_pair(i - 1, i));
+    builder.addEdge(ids.at(i - 1), ids.at(i));
+  }
+  timer.restart();
+  AirWiresBuilder::AirWires airwires2 = builder.buildAirWires();
+  qint64 rebuildTime = timer.nsecsElapsed();
+  EXPECT_LT(airwires2.count(), airwires.count());
+
+  // for comparison, the same with a new builder (like before builders were
+  // kept between rebuilds)
+  timer.restart();
+  AirWiresBuilder fullBuilder;
+  foreach (const Point& point, points) { fullBuilder.addPoint(point); }
+  for (const auto& edge : edges) {
+    fullBuilder.addEdge(edge.first, edge.second);
+  }
+  AirWiresBuilder::AirWires airwires3 = fullBuilder.buildAirWires();
+  qint64 fullRebuildTime = timer.nsecsElapsed();
+  EXPECT_EQ(sorted(airwires3), sorted(airwires2));
+
+  // moving a point requires a new triangulation, but nothing else
+  builder.removePoint(ids.takeLast());
+  ids.append(builder.addPoint(Point(-1270000, -1270000)));
+  timer.restart();
+  builder.buildAirWires();
+  qint64 movedPointTime = timer.nsecsElapsed();
+
+  std::cout << "Points: " << points.count() << std::endl;
+  std::cout << "Initial build: " << (initialTime / 1000000) << " ms"
+            << std::endl;
+  std::cout << "Rebuild after adding edges: " << (rebuildTime / 1000000)
+            << " ms" << std::endl;
+  std::cout << "Full rebuild with a new builder: "
+            << (fullRebuildTime / 1000000) << " ms" << std::endl;
+  std::cout << "Rebuild after moving a point: " << (movedPointTime / 1000000)
+            << " ms" << std::endl;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
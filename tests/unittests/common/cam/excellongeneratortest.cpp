@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/excellongenerator.h>
+#include <librepcb/common/toolbox.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ExcellonGeneratorTest : public ::testing::Test {
+protected:
+  static QList<QStringList> getDrillsPerTool(const QString& output) {
+    QList<QStringList> tools;
+    foreach (const QString& line, output.split('\n')) {
+      if (line.startsWith('T') && (line != "T0")) {
+        tools.append(QStringList());
+      } else if (line.startsWith('X') && (!tools.isEmpty())) {
+        tools.last().append(line);
+      }
+    }
+    return tools;
+  }
+
+  static qreal calcTravelDistance(const QList<QStringList>& tools) {
+    QRegularExpression regex("^X([-0-9.]+)Y([-0-9.]+)$");
+    qreal              distance = 0;
+    QPointF            lastPos;
+    foreach (const QStringList& drills, tools) {
+      foreach (const QString& drill, drills) {
+        QRegularExpressionMatch match = regex.match(drill);
+        QPointF pos(match.captured(1).toDouble(), match.captured(2).toDouble());
+        QPointF diff = pos - lastPos;
+        distance += qSqrt(diff.x() * diff.x() + diff.y() * diff.y());
+        lastPos = pos;
+      }
+    }
+    return distance;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ExcellonGeneratorTest, testOptimizeToolPath) {
+  // holes in a pseudo-random order, like when sorted by UUID
+  ExcellonGenerator gen;
+  for (int i = 0; i < 500; ++i) {
+    int n = (i * 337) % 500;
+    gen.drill(Point::fromMm(n % 25, n / 25), PositiveLength(300000));
+    gen.drill(Point::fromMm(n % 25 + 0.5, n / 25), PositiveLength(800000));
+  }
+  gen.generate();
+  QList<QStringList> unoptimized = getDrillsPerTool(gen.toStr());
+  gen.setOptimizeToolPath(true);
+  gen.generate();
+  QList<QStringList> optimized = getDrillsPerTool(gen.toStr());
+
+  // the same holes must be drilled with the same tools, but with much less
+  // travel distance
+  ASSERT_EQ(2, unoptimized.count());
+  ASSERT_EQ(2, optimized.count());
+  for (int i = 0; i < optimized.count(); ++i) {
+    EXPECT_EQ(500, optimized.at(i).count());
+    EXPECT_EQ(Toolbox::toSet(unoptimized.at(i)),
+              Toolbox::toSet(optimized.at(i)));
+  }
+  EXPECT_LT(calcTravelDistance(optimized), calcTravelDistance(unoptimized) / 5);
+}
+
+TEST_F(ExcellonGeneratorTest, testOptimizeToolPathOfRow) {
+  ExcellonGenerator gen;
+  gen.setOptimizeToolPath(true);
+  QList<int> order = {5, 2, 8, 1, 9, 3, 7, 4, 6};
+  foreach (int x, order) {
+    gen.drill(Point::fromMm(x, 1), PositiveLength(300000));
+  }
+  gen.generate();
+  QList<QStringList> tools = getDrillsPerTool(gen.toStr());
+  ASSERT_EQ(1, tools.count());
+  EXPECT_EQ(QStringList({"X1.0Y1.0", "X2.0Y1.0", "X3.0Y1.0", "X4.0Y1.0",
+                         "X5.0Y1.0", "X6.0Y1.0", "X7.0Y1.0", "X8.0Y1.0",
+                         "X9.0Y1.0"}),
+            tools.first());
+}
+
+TEST_F(ExcellonGeneratorTest, testOptimizeToolPathOfManyHoles) {
+  // a grid of 100x100 holes with 1mm pitch in a pseudo-random order, the
+  // shortest path from the origin through all holes is 9999mm long
+  ExcellonGenerator gen;
+  gen.setOptimizeToolPath(true);
+  for (int i = 0; i < 10000; ++i) {
+    int n = (i * 7919) % 10000;
+    gen.drill(Point::fromMm(n % 100, n / 100), PositiveLength(300000));
+  }
+  gen.generate();
+  QList<QStringList> tools = getDrillsPerTool(gen.toStr());
+  ASSERT_EQ(1, tools.count());
+  EXPECT_EQ(10000, tools.first().count());
+  EXPECT_EQ(10000, Toolbox::toSet(tools.first()).count());
+  EXPECT_LT(calcTravelDistance(tools), 10500);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  GerberGeneratorTest() { mTmpDir = FilePath::getRandomTempPath(); }
+
+  virtual ~GerberGeneratorTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+
+  static QString calcMd5Checksum(QString content) {
+    content.truncate(content.indexOf("%TF.MD5,"));
+    content.remove('\n');
+    return QString(
+        QCryptographicHash::hash(content.toUtf8(), QCryptographicHash::Md5)
+            .toHex());
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GerberGeneratorTest, testDrawLine) {
+  GerberGenerator gen("Project", Uuid::createRandom(), "1.0");
+  gen.drawLine(Point(1000000, -2000000), Point(-3000000, 4000000),
+               UnsignedLength(200000));
+  gen.generate();
+  QString output = gen.toStr();
+  EXPECT_TRUE(output.contains("%ADD10C,0.2*%\n"));
+  EXPECT_TRUE(output.contains("D10*\nX1000000Y-2000000D02*\n"
+                              "X-3000000Y4000000D01*\n"));
+  EXPECT_TRUE(output.contains(
+      QString("%TF.MD5,%1*%\nM02*\n").arg(calcMd5Checksum(output))));
+  EXPECT_TRUE(output.endsWith("M02*\n"));
+}
+
+TEST_F(GerberGeneratorTest, testApertureDeduplication) {
+  GerberGenerator gen("Project", Uuid::createRandom(), "1.0");
+  UnsignedLength  w(1000000);
+  UnsignedLength  h(500000);
+  UnsignedLength  noHole(0);
+  gen.flashRect(Point(0, 0), w, h, Angle::deg0(), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle::deg180(), noHole);
+  gen.flashRect(Point(0, 0), h, w, Angle::deg90(), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle::deg45(), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle::deg45(), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle(30000000), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle(225000000), noHole);
+  gen.flashRect(Point(0, 0), w, h, Angle(-150000000), noHole);
+  gen.flashObround(Point(0, 0), w, h, Angle(30000000), noHole);
+  gen.flashObround(Point(0, 0), w, h, Angle(210000000), noHole);
+  gen.flashObround(Point(0, 0), w, h, Angle(-330000000), noHole);
+  gen.generate();
+  QString output = gen.toStr();
+  EXPECT_EQ(1, output.count("%AMROTATEDRECT*"));
+  EXPECT_TRUE(output.contains("%ADD10R,1.0X0.5*%\n"));
+  EXPECT_TRUE(output.contains("%ADD11ROTATEDRECT,1.0X0.5X45.0*%\n"));
+  EXPECT_TRUE(output.contains("%ADD12ROTATEDRECT,1.0X0.5X30.0*%\n"));
+  EXPECT_TRUE(output.contains("%ADD13ROTATEDOBROUND,"));
+  EXPECT_FALSE(output.contains("%ADD14"));
+}
+
+TEST_F(GerberGeneratorTest, testSaveLargeLayer) {
+  // big enough to be spooled to a temporary file
+  GerberGenerator gen("Project", Uuid::createRandom(), "1.0");
+  for (int i = 0; i < 100000; ++i) {
+    gen.drawLine(Point(i, -i), Point(i * 2, i * 3),
+                 UnsignedLength(100000 + (i % 3) * 100000));
+  }
+  gen.generate();
+  FilePath fp = mTmpDir.getPathTo("large.gbr");
+  gen.saveToFile(fp);
+  QString output = QString::fromLatin1(FileUtils::readFile(fp));
+  EXPECT_EQ(gen.toStr(), output);
+  EXPECT_TRUE(output.contains("X199998Y299997D01*\nG04 --- BOARD END --- *\n"));
+  EXPECT_TRUE(output.contains(
+      QString("%TF.MD5,%1*%\nM02*\n").arg(calcMd5Checksum(output))));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
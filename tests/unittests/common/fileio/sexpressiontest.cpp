@@ -0,0 +1,251 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {
+protected:
+  FilePath mFilePath = FilePath("/tmp/test.lp");
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionTest, testParseList) {
+  SExpression root = SExpression::parse(
+      "(librepcb_board 1234\n (name \"Foo Bar\")\n (empty)\n)\n", mFilePath);
+  EXPECT_TRUE(root.isList());
+  EXPECT_EQ("librepcb_board", root.getName().toStdString());
+  ASSERT_EQ(3, root.getChildren().count());
+  EXPECT_EQ("1234", root.getChildByIndex(0).getValue<QString>().toStdString());
+  EXPECT_EQ("Foo Bar", root.getValueByPath<QString>("name").toStdString());
+  EXPECT_EQ(0, root.getChildByPath("empty").getChildren().count());
+}
+
+TEST_F(SExpressionTest, testParseFilePathAndPosition) {
+  SExpression root =
+      SExpression::parse("(root\n  (child foo \"bar\")\n)", mFilePath);
+  const SExpression& child = root.getChildByPath("child");
+  EXPECT_TRUE(root.getFilePath() == mFilePath);
+  EXPECT_TRUE(child.getFilePath() == mFilePath);
+  EXPECT_EQ(1, root.getLine());
+  EXPECT_EQ(1, root.getColumn());
+  EXPECT_EQ(2, child.getLine());
+  EXPECT_EQ(3, child.getColumn());
+  EXPECT_EQ(2, child.getChildByIndex(0).getLine());
+  EXPECT_EQ(10, child.getChildByIndex(0).getColumn());
+  EXPECT_EQ(14, child.getChildByIndex(1).getColumn());
+}
+
+TEST_F(SExpressionTest, testParseEscapedString) {
+  SExpression root = SExpression::parse(
+      "(text \"a\\\"b\\\\c\\nd\\te\")", mFilePath);
+  EXPECT_EQ("a\"b\\c\nd\te",
+            root.getValueOfFirstChild<QString>().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseQuotedListName) {
+  SExpression root = SExpression::parse("(\"root\" (\"a b\" c))", mFilePath);
+  EXPECT_EQ("root", root.getName().toStdString());
+  ASSERT_EQ(1, root.getChildren().count());
+  const SExpression& child = root.getChildByIndex(0);
+  EXPECT_EQ("a b", child.getName().toStdString());
+  EXPECT_EQ("c", child.getValueOfFirstChild<QString>().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseUtf8) {
+  SExpression root =
+      SExpression::parse(QString("(text \"\u00e4\u00f6\u00fc\")").toUtf8(),
+                         mFilePath);
+  EXPECT_EQ(QString("\u00e4\u00f6\u00fc"),
+            root.getValueOfFirstChild<QString>());
+}
+
+TEST_F(SExpressionTest, testParseComment) {
+  SExpression root = SExpression::parse(
+      "; comment\n(root ; another (comment\n foo)\n", mFilePath);
+  ASSERT_EQ(1, root.getChildren().count());
+  EXPECT_EQ("foo", root.getValueOfFirstChild<QString>().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseErrors) {
+  EXPECT_THROW(SExpression::parse("", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a) (b)", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a (b)", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a))", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a ())", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("((a) b)", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a \"b)", mFilePath), FileParseError);
+  EXPECT_THROW(SExpression::parse("(a \"\\x\")", mFilePath), FileParseError);
+}
+
+TEST_F(SExpressionTest, testParseWithMaxDepth) {
+  SExpression root = SExpression::parse(
+      "(root (a 1 (b \")\" ; (\n (c 2)))\n (d 3))", mFilePath, 1);
+  ASSERT_EQ(2, root.getChildren().count());
+  EXPECT_EQ(1, root.getChildByPath("a").getChildren().count());
+  EXPECT_EQ(3, root.getValueByPath<int>("d"));
+  EXPECT_EQ(3, root.getChildByPath("d").getLine());
+  EXPECT_THROW(SExpression::parse("(a (b (c))", mFilePath, 0), FileParseError);
+}
+
+TEST_F(SExpressionTest, testParseHeaderOnly) {
+  // the rest of the file is not parsed at all, thus may even be invalid
+  SExpression root = SExpression::parse(
+      "(root 0 (a 1 (x 2)) (\"b\" 3) (c 4) (a 5) \"(\"", mFilePath, 1,
+      {"a", "b"});
+  ASSERT_EQ(3, root.getChildren().count());
+  EXPECT_EQ(1, root.getChildByPath("a").getChildren().count());
+  EXPECT_EQ(3, root.getValueByPath<int>("b"));
+  EXPECT_EQ(nullptr, root.tryGetChildByPath("c"));
+  EXPECT_THROW(SExpression::parse("(root (a 1)", mFilePath, 1, {"a"}),
+               FileParseError);
+}
+
+TEST_F(SExpressionTest, testGetChildrenByName) {
+  SExpression root =
+      SExpression::parse("(root (a 1) (b 2) (a 3) \"a\")", mFilePath);
+  SExpression::ChildRefs children = root.getChildren("a");
+  ASSERT_EQ(2, children.count());
+  EXPECT_EQ(&root.getChildren().at(0), &children.at(0).get());
+  EXPECT_EQ(&root.getChildren().at(2), &children.at(1).get());
+  EXPECT_EQ(0, root.getChildren("c").count());
+}
+
+TEST_F(SExpressionTest, testForEachChild) {
+  SExpression root =
+      SExpression::parse("(root (a 1) (b 2) (a 3) \"a\")", mFilePath);
+  QList<const SExpression*> children;
+  root.forEachChild("a",
+                    [&children](const SExpression& c) { children.append(&c); });
+  ASSERT_EQ(2, children.count());
+  EXPECT_EQ(&root.getChildren().at(0), children.at(0));
+  EXPECT_EQ(&root.getChildren().at(2), children.at(1));
+  root.forEachChild("c", [](const SExpression&) { FAIL(); });
+}
+
+TEST_F(SExpressionTest, testGetChildrenOfWideList) {
+  SExpression root = SExpression::createList("root");
+  for (int i = 0; i < 100; ++i) {
+    root.appendList((i % 2) ? "odd" : "even", true).appendChild(i);
+  }
+  EXPECT_EQ(50, root.getChildren("odd").count());
+  EXPECT_EQ(50, root.getChildren("even").count());
+  EXPECT_EQ(98, root.getChildByPath("even").getValueOfFirstChild<int>());
+  EXPECT_EQ(nullptr, root.tryGetChildByPath("foo"));
+
+  // the lookup must still work after modifying the children
+  root.appendList("foo", true).appendChild(100);
+  root.appendList("even", true).appendChild(101);
+  EXPECT_EQ(51, root.getChildren("even").count());
+  EXPECT_EQ(101, root.getChildByPath("even").getValueOfFirstChild<int>());
+  EXPECT_EQ(100, root.getChildByPath("foo").getValueOfFirstChild<int>());
+  root.removeLineBreaks();
+  EXPECT_EQ(1, root.getChildren("foo").count());
+  EXPECT_EQ(&root.getChildren().last(), &root.getChildByPath("even"));
+
+  // copies must not reference the children of the original
+  SExpression copy = root;
+  EXPECT_EQ(&copy.getChildren().last(), &copy.getChildByPath("even"));
+}
+
+TEST_F(SExpressionTest, DISABLED_benchmarkWideNetSegment) {
+  // build a net segment with 100k netlines, similar to a big board
+  QByteArray content = "(netsegment 3f6f7a3c-6c3b-4f5e-9a2f-6d1b6c9f1e2a\n";
+  for (int i = 0; i < 100000; ++i) {
+    QByteArray uuid = QUuid::createUuid().toByteArray().mid(1, 36);
+    content += " (netline " + uuid + " (layer top_cu) (width 0.25)\n";
+    content += "  (from (junction " + uuid + "))\n";
+    content += "  (to (junction " + uuid + "))\n";
+    content += " )\n";
+  }
+  content += ")\n";
+
+  QElapsedTimer timer;
+  timer.start();
+  SExpression root = SExpression::parse(content, mFilePath);
+  qint64 parseTime = timer.restart();
+  int count = 0;
+  foreach (const SExpression& child, root.getChildren("netline")) {
+    child.getChildByPath("layer");
+    child.getChildByPath("width");
+    child.getChildByPath("from/junction");
+    child.getChildByPath("to/junction");
+    ++count;
+  }
+  qint64 lookupTime = timer.elapsed();
+  EXPECT_EQ(100000, count);
+  std::cout << "Parsed in " << parseTime << "ms, looked up children in "
+            << lookupTime << "ms" << std::endl;
+}
+
+TEST_F(SExpressionTest, testSerialize) {
+  SExpression root = SExpression::createList("root");
+  root.appendChild(SExpression::createToken("foo"), false);
+  SExpression& child = root.appendList("child", true);
+  child.appendChild(SExpression::createString("bar"), false);
+  child.appendChild(SExpression::createToken("baz"), true);
+  EXPECT_EQ("(root foo\n (child \"bar\"\n  baz\n )\n)\n",
+            root.toByteArray().toStdString());
+}
+
+TEST_F(SExpressionTest, testSerializeEscapedString) {
+  SExpression root = SExpression::createList("root");
+  root.appendChild(SExpression::createString("a\"b\\c\nd \u00e4"), false);
+  SExpression parsed = SExpression::parse(root.toByteArray(), mFilePath);
+  EXPECT_EQ(QString("a\"b\\c\nd \u00e4"),
+            parsed.getValueOfFirstChild<QString>());
+}
+
+TEST_F(SExpressionTest, testSerializeInvalidNames) {
+  EXPECT_THROW(SExpression::createList("Foo").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createList("1foo").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createToken("").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createToken("a b").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createToken("\u00e4").toByteArray(), LogicError);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -161,6 +161,27 @@ TEST_F(TransactionalFileSystemTest, testWriteIsDelayedUntilSave) {
   EXPECT_EQ("content", FileUtils::readFile(fp));
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnchangedFileIsSkipped) {
+  FilePath                fp = mPopulatedDir.getPathTo("1.txt");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1", fs.read("1.txt"));
+  fs.write("1.txt", "modified");
+  fs.write("1.txt", "1");  // same content as on disk
+  fs.write("new.txt", "new");
+  // modify the file on disk to detect whether it gets overwritten by save()
+  FileUtils::writeFile(fp, "external");
+  fs.save();
+  EXPECT_EQ("external", FileUtils::readFile(fp));
+  EXPECT_EQ("new", FileUtils::readFile(mPopulatedDir.getPathTo("new.txt")));
+
+  // saved content is known as well
+  FileUtils::writeFile(mPopulatedDir.getPathTo("new.txt"), "external");
+  fs.write("new.txt", "new");
+  fs.save();
+  EXPECT_EQ("external",
+            FileUtils::readFile(mPopulatedDir.getPathTo("new.txt")));
+}
+
 TEST_F(TransactionalFileSystemTest, testRemoveExistingFile) {
   FilePath                fp = mPopulatedDir.getPathTo("1/1a.txt");
   TransactionalFileSystem fs(mPopulatedDir, true);
@@ -440,6 +461,25 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testAutosaveAsyncWritesSnapshot) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "snapshot");
+  QFuture<void> future = fs.autosaveAsync();
+  fs.write("1.txt", "modified after autosave");  // must not be autosaved
+  fs.write("new.txt", "new");                     // must not be autosaved
+  future.waitForFinished();
+
+  // remove lock because we can't get a stale lock without crashing the app
+  FileUtils::removeFile(mPopulatedDir.getPathTo(".lock"));
+
+  // open another file system on the same directory to restore the autosave
+  TransactionalFileSystem fs2(mPopulatedDir, true,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("snapshot", fs2.read("1.txt"));
+  EXPECT_FALSE(fs2.fileExists("new.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/toolbox.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperHelpersTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperHelpersTest, testSimplifyCircle) {
+  // a finely flattened circle, like plane fragments often contain
+  ClipperLib::Path circle;
+  for (int i = 0; i <= 5000; ++i) {
+    qreal angle = 2 * M_PI * i / 5000;
+    circle.push_back(ClipperHelpers::convert(
+        Point::fromMm(5 + std::cos(angle) * 4, 5 + std::sin(angle) * 4)));
+  }
+  ClipperLib::Paths paths = {circle};
+  ClipperHelpers::simplify(paths, UnsignedLength(1000));
+  ASSERT_EQ(1u, paths.size());
+  const ClipperLib::Path& simplified = paths.front();
+
+  // the path stays closed
+  EXPECT_EQ(circle.front(), simplified.front());
+  EXPECT_EQ(circle.back(), simplified.back());
+
+  // a 1um tolerance requires about 140 vertices for this circle, so the
+  // vertex count must be reduced a lot, but not more than possible
+  EXPECT_LT(simplified.size(), 200u);
+  EXPECT_GT(simplified.size(), 100u);
+
+  // all removed vertices are within the tolerance
+  for (const ClipperLib::IntPoint& p : circle) {
+    Length minDistance(-1);
+    for (std::size_t i = 1; i < simplified.size(); ++i) {
+      Length distance = *Toolbox::shortestDistanceBetweenPointAndLine(
+          ClipperHelpers::convert(p),
+          ClipperHelpers::convert(simplified.at(i - 1)),
+          ClipperHelpers::convert(simplified.at(i)));
+      if ((minDistance < Length(0)) || (distance < minDistance)) {
+        minDistance = distance;
+      }
+    }
+    EXPECT_LE(minDistance.toNm(), 1000);
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -21,14 +21,19 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardfabricationoutputsettings.h>
 #include <librepcb/project/boards/boardgerberexport.h>
 #include <librepcb/project/project.h>
 
 #include <QtCore>
+#include <QtGui>
+
+#include <cmath>
 
 /*******************************************************************************
  *  Namespace
@@ -55,13 +60,76 @@ namespace tests {
  * with Git (i.e. verify if the diff is as expected and makes sense) and then
  * commit those changes.
  */
-class BoardGerberExportTest : public ::testing::Test {};
+class BoardGerberExportTest : public ::testing::Test {
+protected:
+  static QVector<Path> parseRegions(const QString& gerber) {
+    // only linear segments are supported, which is enough for merged areas
+    QRegularExpression re("^X(-?\\d+)Y(-?\\d+)D0[12]\\*$");
+    QVector<Path>      regions;
+    bool               inRegion = false;
+    foreach (const QString& line, gerber.split('\n')) {
+      if (line == "G36*") {
+        regions.append(Path());
+        inRegion = true;
+      } else if (line == "G37*") {
+        inRegion = false;
+      } else if (inRegion) {
+        QRegularExpressionMatch match = re.match(line);
+        EXPECT_TRUE(match.hasMatch()) << qPrintable(line);
+        regions.last().addVertex(Point(match.captured(1).toLongLong(),
+                                       match.captured(2).toLongLong()));
+      }
+    }
+    return regions;
+  }
+
+  static QImage rasterize(const QVector<Path>& paths) {
+    // 20um per pixel, area from (0, 0) to (20mm, 20mm)
+    QImage image(1000, 1000, QImage::Format_RGB32);
+    image.fill(Qt::black);
+    QPainter painter(&image);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::white);
+    painter.scale(50, 50);
+    foreach (const Path& path, paths) {
+      QPainterPath p;
+      p.setFillRule(Qt::WindingFill);
+      foreach (const Vertex& vertex, path.getVertices()) {
+        QPointF pos(vertex.getPos().getX().toMm(),
+                    vertex.getPos().getY().toMm());
+        if (p.elementCount() == 0) {
+          p.moveTo(pos);
+        } else {
+          p.lineTo(pos);
+        }
+      }
+      painter.drawPath(p);
+    }
+    return image;
+  }
+
+  static int countDifferentPixels(const QImage& a, const QImage& b) {
+    int count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+      for (int x = 0; x < a.width(); ++x) {
+        if (a.pixel(x, y) != b.pixel(x, y)) ++count;
+      }
+    }
+    return count;
+  }
+
+  static int countVertices(const QVector<Path>& paths) {
+    int count = 0;
+    foreach (const Path& path, paths) { count += path.getVertices().count(); }
+    return count;
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
  ******************************************************************************/
 
-TEST(BoardGerberExportTest, test) {
+TEST_F(BoardGerberExportTest, test) {
   FilePath testDataDir(TEST_DATA_DIR
                        "/unittests/librepcbproject/BoardGerberExportTest");
 
@@ -117,6 +185,51 @@ TEST(BoardGerberExportTest, test) {
   }
 }
 
+TEST_F(BoardGerberExportTest, testDrawMergedAreas) {
+  // a finely flattened circle, like plane fragments often contain
+  Path circle;
+  for (int i = 0; i < 5000; ++i) {
+    qreal angle = 2 * M_PI * i / 5000;
+    circle.addVertex(
+        Point::fromMm(5 + std::cos(angle) * 4, 5 + std::sin(angle) * 4));
+  }
+  circle.close();
+  // overlapping rectangles with different orientations, one of them with a
+  // hole (represented by a cut-in)
+  Path rect1 = Path::rect(Point(11000000, 1000000), Point(16000000, 9000000));
+  Path rect2 = Path::rect(Point(19000000, 5000000), Point(14000000, 19000000));
+  Path rect3 = Path::rect(Point(1000000, 11000000), Point(16000000, 16000000));
+  ClipperLib::Paths holes = {
+      ClipperHelpers::convert(Path::rect(Point(2000000, 12000000),
+                                         Point(3000000, 13000000)),
+                              PositiveLength(1))};
+  ClipperLib::Paths rect3Paths = {
+      ClipperHelpers::convert(rect3, PositiveLength(1))};
+  ClipperHelpers::subtract(rect3Paths, holes);
+  std::unique_ptr<ClipperLib::PolyTree> rect3Tree =
+      ClipperHelpers::uniteToTree(rect3Paths);
+  QVector<Path> areas = {circle, rect1, rect2};
+  areas += ClipperHelpers::convert(ClipperHelpers::flattenTree(*rect3Tree));
+  ASSERT_EQ(4, areas.count());
+
+  // draw them the same way as done for planes and polygons
+  GerberGenerator gen("Test", Uuid::createRandom(), "1");
+  BoardGerberExport::drawMergedAreas(gen, areas, UnsignedLength(1000));
+  gen.generate();
+  QVector<Path> merged = parseRegions(gen.toStr());
+
+  // the circle and the (merged) rectangles remain
+  EXPECT_EQ(2, merged.count());
+  EXPECT_LT(countVertices(merged), countVertices(areas) / 2);
+
+  // the rasterized output must look the same as before, except some pixels
+  // along the edges due to the tolerance (max. 0.1% of all pixels)
+  QImage before = rasterize(areas);
+  QImage after  = rasterize(merged);
+  EXPECT_GT(countDifferentPixels(before, rasterize({})), 100000);
+  EXPECT_LE(countDifferentPixels(before, after), 1000);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
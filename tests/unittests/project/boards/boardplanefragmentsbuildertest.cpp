@@ -24,6 +24,7 @@
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
 #include <librepcb/project/boards/items/bi_plane.h>
 #include <librepcb/project/project.h>
 
@@ -109,6 +110,65 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuild) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  QScopedPointer<Project> project(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename()));
+  Board* board = project->getBoards().first();
+
+  QSet<Uuid> allPlanes;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    allPlanes.insert(plane->getUuid());
+  }
+  ASSERT_FALSE(allPlanes.isEmpty());
+
+  // initial full rebuild
+  BoardPlaneFragmentsBuilder initial(*board);
+  QHash<Uuid, QVector<Path>> initialFragments = initial.buildFragments();
+  EXPECT_EQ(allPlanes, initial.getRebuiltPlanes());
+
+  // rebuild without any modifications must reuse all fragments
+  BoardPlaneFragmentsBuilder unmodified(*board, &initial);
+  EXPECT_EQ(initialFragments, unmodified.buildFragments());
+  EXPECT_EQ(QSet<Uuid>(), unmodified.getRebuiltPlanes());
+
+  // no other plane depends on the plane with the lowest priority on a layer,
+  // so modifying it must rebuild only this plane
+  BI_Plane* plane = board->getPlanes().first();
+  foreach (BI_Plane* other, board->getPlanes()) {
+    if ((other->getLayerName() == plane->getLayerName()) && (*other < *plane)) {
+      plane = other;
+    }
+  }
+  UnsignedLength minWidth = plane->getMinWidth();
+  plane->setMinWidth(UnsignedLength(*minWidth + 100000));
+  BoardPlaneFragmentsBuilder incremental(*board, &unmodified);
+  QHash<Uuid, QVector<Path>> incrementalFragments =
+      incremental.buildFragments();
+  EXPECT_EQ(QSet<Uuid>{plane->getUuid()}, incremental.getRebuiltPlanes());
+  foreach (const Uuid& uuid, allPlanes) {
+    if (uuid != plane->getUuid()) {
+      EXPECT_EQ(initialFragments.value(uuid), incrementalFragments.value(uuid));
+    }
+  }
+
+  // the incremental rebuild must lead to exactly the same fragments as a full
+  // rebuild
+  BoardPlaneFragmentsBuilder full(*board);
+  EXPECT_EQ(full.buildFragments(), incrementalFragments);
+
+  // reverting the modification must rebuild the same plane again
+  plane->setMinWidth(minWidth);
+  BoardPlaneFragmentsBuilder reverted(*board, &incremental);
+  EXPECT_EQ(initialFragments, reverted.buildFragments());
+  EXPECT_EQ(QSet<Uuid>{plane->getUuid()}, reverted.getRebuiltPlanes());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -21,9 +21,11 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/project/metadata/projectmetadata.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/schematics/schematic.h>
 
 #include <QtCore>
 
@@ -137,6 +139,30 @@ TEST_F(ProjectTest, testSave) {
   project.reset(new Project(createDir(), mProjectFile.getFilename()));
 }
 
+TEST_F(ProjectTest, testSaveOnlyModifiedSchematics) {
+  // create new project with a schematic
+  QScopedPointer<Project> project(
+      Project::create(createDir(), mProjectFile.getFilename()));
+  Schematic* schematic = project->createSchematic(ElementName("foo"));
+  project->addSchematic(*schematic);
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  FilePath fp = schematic->getFilePath();
+  ASSERT_TRUE(fp.isExistingFile());
+
+  // modify the file on disk to detect whether it gets overwritten by save()
+  FileUtils::writeFile(fp, "external");
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  EXPECT_EQ("external", FileUtils::readFile(fp));
+
+  // modified schematics must be saved
+  schematic->setName(ElementName("bar"));
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  EXPECT_NE("external", FileUtils::readFile(fp));
+}
+
 TEST_F(ProjectTest, testIfLastModifiedDateTimeIsUpdatedOnSave) {
   // create new project
   QScopedPointer<Project> project(